@@ -0,0 +1,101 @@
+/**
+ * @file cabinetConfig.cpp
+ * @brief Implementierung der persistenten Konfiguration im Flash.
+ *
+ * Die Daten liegen im letzten 4-KB-Sektor des Flash und werden über das XIP-Fenster gelesen.
+ * Geschrieben wird nur, wenn sich der Inhalt tatsächlich geändert hat (Flash-Verschleiß).
+ *
+ * @author Knut Welzel <knut.welzel@gmail.com>
+ * @date 2025-09-13
+ * @copyright MIT
+ */
+
+#include "cabinetConfig.h"
+
+#include <cstring>
+#include <cstddef>
+#include <algorithm>
+#include "hardware/flash.h"  // Für flash_range_erase(), flash_range_program()
+#include "hardware/sync.h"   // Für save_and_disable_interrupts()
+
+// Lage der Konfiguration: letzter Sektor des Flash
+static constexpr uint32_t CONFIG_FLASH_OFFSET = PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE;
+
+// Beginn der Nutzdaten (Bereich der CRC)
+static constexpr size_t PAYLOAD_OFFSET = offsetof(CabinetConfig, sensorChannelMap);
+
+// Die Konfiguration wird als eine Flash-Page geschrieben
+static_assert(sizeof(CabinetConfig) <= FLASH_PAGE_SIZE, "CabinetConfig muss in eine Flash-Page passen");
+
+// Standardkonfiguration: Sensor i steuert Kanal i, alle Kanäle mit OR, alle Sensoren als Reedkontakt,
+// Standard-Fading in beide Richtungen, kein Nachleuchten
+CabinetConfig ConfigStore::defaults() {
+    CabinetConfig cfg = {};
+    cfg.magic = CabinetConfig::MAGIC;
+    cfg.version = CabinetConfig::VERSION;
+    cfg.size = sizeof(CabinetConfig);
+    for (size_t s = 0; s < CabinetConfig::CHANNELS; ++s) {
+        cfg.sensorChannelMap[s] = static_cast<uint8_t>(1u << s);
+    }
+    cfg.channelAndMask = 0;
+    cfg.triggerType.fill(static_cast<uint8_t>(TriggerType::REED));
+    cfg.pirHoldS.fill(60);
+    cfg.fadeInMs.fill(0);
+    cfg.fadeOutMs.fill(0);
+    cfg.afterglowS.fill(0);
+    return cfg;
+}
+
+// Lädt die Konfiguration; ältere (kürzere) Versionen werden mit Standardwerten ergänzt
+bool ConfigStore::load(CabinetConfig& cfg) {
+    const uint8_t* flash = reinterpret_cast<const uint8_t*>(XIP_BASE + CONFIG_FLASH_OFFSET);
+    cfg = defaults();
+
+    CabinetConfig header;
+    std::memcpy(&header, flash, PAYLOAD_OFFSET);
+    if (header.magic != CabinetConfig::MAGIC) return false;
+    if (header.size <= PAYLOAD_OFFSET || header.size > FLASH_PAGE_SIZE) return false;
+    if (crc32(flash + PAYLOAD_OFFSET, header.size - PAYLOAD_OFFSET) != header.crc) return false;
+
+    // Bekannte Felder übernehmen, neuere Felder behalten ihre Standardwerte
+    size_t known = std::min<size_t>(header.size, sizeof(CabinetConfig));
+    std::memcpy(reinterpret_cast<uint8_t*>(&cfg) + PAYLOAD_OFFSET, flash + PAYLOAD_OFFSET, known - PAYLOAD_OFFSET);
+    return true;
+}
+
+// Speichert die Konfiguration im letzten Flash-Sektor
+bool ConfigStore::save(CabinetConfig& cfg) {
+    cfg.magic = CabinetConfig::MAGIC;
+    cfg.version = CabinetConfig::VERSION;
+    cfg.size = sizeof(CabinetConfig);
+    cfg.crc = crc32(reinterpret_cast<const uint8_t*>(&cfg) + PAYLOAD_OFFSET, sizeof(CabinetConfig) - PAYLOAD_OFFSET);
+
+    // Unveränderte Daten nicht erneut schreiben
+    const uint8_t* flash = reinterpret_cast<const uint8_t*>(XIP_BASE + CONFIG_FLASH_OFFSET);
+    if (std::memcmp(flash, &cfg, sizeof(CabinetConfig)) == 0) return true;
+
+    // Page-Puffer: ungenutzte Bytes bleiben im gelöschten Zustand (0xFF)
+    static uint8_t page[FLASH_PAGE_SIZE];
+    std::memset(page, 0xFF, sizeof(page));
+    std::memcpy(page, &cfg, sizeof(CabinetConfig));
+
+    // Während Löschen/Schreiben darf nicht aus dem Flash ausgeführt werden
+    uint32_t irq = save_and_disable_interrupts();
+    flash_range_erase(CONFIG_FLASH_OFFSET, FLASH_SECTOR_SIZE);
+    flash_range_program(CONFIG_FLASH_OFFSET, page, FLASH_PAGE_SIZE);
+    restore_interrupts(irq);
+
+    return std::memcmp(flash, &cfg, sizeof(CabinetConfig)) == 0;
+}
+
+// CRC32 (Polynom 0xEDB88320), bitweise – klein statt schnell, da nur beim Laden/Speichern benötigt
+uint32_t ConfigStore::crc32(const uint8_t* data, size_t len) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; ++i) {
+        crc ^= data[i];
+        for (int b = 0; b < 8; ++b) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
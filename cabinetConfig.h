@@ -0,0 +1,152 @@
+/**
+ * @file cabinetConfig.h
+ * @brief Persistente Konfiguration der Schrankbeleuchtung im Flash (Header).
+ *
+ * Die Konfiguration liegt im letzten Flash-Sektor und besteht aus einem Header (Magic, Version,
+ * Größe, CRC32) und den Nutzdaten. Neue Felder werden ausschließlich am Ende angehängt: Beim
+ * Laden einer älteren, kürzeren Konfiguration werden die bekannten Felder übernommen und die
+ * neuen Felder mit Standardwerten belegt.
+ *
+ * \par Inhalt
+ * - Sensor-zu-Kanal-Matrix (Bitmaske je Sensor)
+ * - Verknüpfungsregel je Kanal (OR/AND)
+ * - Auslöserart je Sensor (Reed, PIR, Taster) und PIR-Haltezeit
+ * - Fading-Dauer je Kanal und Richtung (Ein-/Ausblenden)
+ * - Nachleuchtdauer je Kanal nach dem Schließen
+ *
+ * \author Knut Welzel <knut.welzel@gmail.com>
+ * \date 2025-09-13
+ * \copyright MIT
+ */
+
+#ifndef CABINET_CONFIG_H
+#define CABINET_CONFIG_H
+
+#include <cstdint>          // Für uint8_t, uint16_t, uint32_t
+#include <cstddef>          // Für size_t
+#include <array>            // Für std::array
+
+/**
+ * @brief Verknüpfung mehrerer Sensoren, die auf denselben Kanal wirken.
+ */
+enum class MapRule : uint8_t {
+    OR  = 0,    ///< Kanal an, sobald einer der zugeordneten Sensoren aktiv ist
+    AND = 1     ///< Kanal an, nur wenn alle zugeordneten Sensoren aktiv sind
+};
+
+/**
+ * @brief Art des Auslösers an einem Sensoreingang.
+ */
+enum class TriggerType : uint8_t {
+    REED   = 0,     ///< Reedkontakt: Pegel entspricht dem Türzustand
+    PIR    = 1,     ///< Bewegungsmelder: aktive Flanke startet/verlängert eine Haltezeit
+    BUTTON = 2      ///< Taster: jeder Druck schaltet um
+};
+
+/**
+ * @struct CabinetConfig
+ * @brief Persistente Konfiguration (Header + Nutzdaten, nur anhängend erweitern).
+ */
+struct CabinetConfig {
+    /**
+     * @brief Anzahl der Sensoren/Kanäle (entspricht CabinetLight::DEV_COUNT).
+     */
+    static constexpr size_t CHANNELS = 4;
+
+    /**
+     * @brief Kennung gültiger Konfigurationsdaten ("CLCF").
+     */
+    static constexpr uint32_t MAGIC = 0x46434C43;
+
+    /**
+     * @brief Aktuelle Formatversion.
+     */
+    static constexpr uint16_t VERSION = 4;
+
+    // === Header ===
+    uint32_t magic;         ///< MAGIC
+    uint16_t version;       ///< Formatversion beim Speichern
+    uint16_t size;          ///< sizeof(CabinetConfig) beim Speichern
+    uint32_t crc;           ///< CRC32 über die Nutzdaten (ab sensorChannelMap, size Bytes)
+
+    // === Version 1 ===
+    /**
+     * @brief Sensor-zu-Kanal-Matrix: Bit c in sensorChannelMap[s] = Sensor s wirkt auf Kanal c.
+     */
+    std::array<uint8_t, CHANNELS> sensorChannelMap;
+
+    /**
+     * @brief Verknüpfungsregel je Kanal: Bit c gesetzt = AND, sonst OR.
+     */
+    uint8_t channelAndMask;
+
+    uint8_t reserved1[3];   ///< Auffüllung (0)
+
+    // === Version 2 ===
+    /**
+     * @brief Auslöserart je Sensor (TriggerType als uint8_t).
+     */
+    std::array<uint8_t, CHANNELS> triggerType;
+
+    /**
+     * @brief Haltezeit je PIR-Sensor in Sekunden (wird mit jedem Puls neu gestartet).
+     */
+    std::array<uint16_t, CHANNELS> pirHoldS;
+
+    // === Version 3 ===
+    /**
+     * @brief Dauer des Einblendens von 0 auf volle Helligkeit je Kanal in ms (0 = Standard).
+     */
+    std::array<uint16_t, CHANNELS> fadeInMs;
+
+    /**
+     * @brief Dauer des Ausblendens von voller Helligkeit auf 0 je Kanal in ms (0 = Standard).
+     */
+    std::array<uint16_t, CHANNELS> fadeOutMs;
+
+    // === Version 4 ===
+    /**
+     * @brief Nachleuchtdauer je Kanal in Sekunden: so lange bleibt das Licht nach dem Schließen an (0 = aus).
+     */
+    std::array<uint16_t, CHANNELS> afterglowS;
+};
+
+/**
+ * @class ConfigStore
+ * @brief Lädt und speichert CabinetConfig im letzten Flash-Sektor.
+ *
+ * \warning save() sperrt während des Löschens/Schreibens alle Interrupts auf dem aufrufenden Kern
+ * (ca. 50 ms) und darf nicht aufgerufen werden, während Kern 1 aus dem Flash ausführt.
+ */
+class ConfigStore {
+
+public:
+    /**
+     * @brief Liefert die Standardkonfiguration (Sensor i -> Kanal i, OR).
+     */
+    static CabinetConfig defaults();
+
+    /**
+     * @brief Lädt die Konfiguration aus dem Flash.
+     *
+     * @param cfg Ausgabe: geladene Konfiguration bzw. Standardwerte
+     * @return true, wenn gültige Daten gefunden wurden, sonst false (cfg enthält dann defaults())
+     */
+    static bool load(CabinetConfig& cfg);
+
+    /**
+     * @brief Speichert die Konfiguration im Flash (nur wenn sie sich geändert hat).
+     *
+     * @param cfg Zu speichernde Konfiguration (Header wird hier gesetzt)
+     * @return true bei Erfolg
+     */
+    static bool save(CabinetConfig& cfg);
+
+private:
+    /**
+     * @brief CRC32 (IEEE, bitweise) über einen Speicherbereich.
+     */
+    static uint32_t crc32(const uint8_t* data, size_t len);
+};
+
+#endif // CABINET_CONFIG_H
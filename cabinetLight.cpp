@@ -40,10 +40,20 @@ void cabinet_gpio_callback(uint gpio, uint32_t events);
 
 #include <algorithm>
 #include <cstdio>
+#include "hardware/sync.h"  // Für __sev()
+#include "pico/platform.h"   // Für __get_current_exception()
+#include "crashReport.h"     // Für das Absturzprotokoll
+#include "supervisor.h"      // Für die Watchdog-Meldungen
+#include "statusLed.h"       // Für die Fehlercode-Anzeige
 // for clock_get_hz()
 #include "hardware/clocks.h"
 
 
+// Animations-Engine und Compositor arbeiten mit derselben Kanalanzahl
+static_assert(CabinetLight::DEV_COUNT == LightAnimation::CHANNELS, "Kanalanzahl von CabinetLight und LightAnimation muss übereinstimmen");
+static_assert(CabinetLight::DEV_COUNT == LightCompositor::CHANNELS, "Kanalanzahl von CabinetLight und LightCompositor muss übereinstimmen");
+static_assert(CabinetLight::DEV_COUNT == EventStats::CHANNELS, "Kanalanzahl von CabinetLight und EventStats muss übereinstimmen");
+
 // Definition der statischen Instanz für Singleton-Pattern (IRQ-Weiterleitung)
 std::atomic<CabinetLight*> CabinetLight::instance = nullptr;
 
@@ -53,19 +63,19 @@ const std::array<uint8_t, CabinetLight::DEV_COUNT> CabinetLight::DEFAULT_SENSOR_
 
 // Konstruktor: Initialisiert alle Kanäle, Pins und Statusarrays
 CabinetLight::CabinetLight() {
-    logDebug("CabinetLight Konstruktor aufgerufen.\n");
+    LOG_DEBUG(INIT, "CabinetLight Konstruktor aufgerufen.\n");
     instance.store(this, std::memory_order_release); // Singleton-Instanz setzen
     ledPins = DEFAULT_LED_PINS;         // Standard-LED-Pins setzen
     sensorPins = DEFAULT_SENSOR_PINS;   // Standard-Sensor-Pins setzen
-    initialized = true;                 // Initialisierungsstatus setzen
 
-    // Initialisiere PWM für alle LED-Pins
-    for (uint8_t gpio : ledPins) {
+    // Initialisiere PWM für alle LED-Pins; fehlerhafte Kanäle werden nur markiert
+    for (size_t i = 0; i < DEV_COUNT; ++i) {
 
         // LED-Pins initialisieren (inkl. PWM-Setup)
-        if (!setupPwmLEDs(gpio)) {
-            logError("PWM-Init fehlgeschlagen für GPIO %d\n", gpio);
-            initialized = false;    // Initialisierung fehlgeschlagen
+        if (setupPwmLEDs(ledPins[i])) {
+            ledHealthyMask |= static_cast<uint8_t>(1u << i);
+        } else {
+            LOG_ERROR(PWM, "PWM-Init fehlgeschlagen für GPIO %d\n", ledPins[i]);
         }
     }
 
@@ -73,40 +83,52 @@ CabinetLight::CabinetLight() {
     gpio_set_irq_enabled_with_callback(sensorPins[0], GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true, cabinet_gpio_callback);
 
     // Sensor-GPIOs initialisieren (inkl. Pull-Down und IRQ)
-    for (uint8_t gpio : sensorPins) {
+    for (size_t i = 0; i < DEV_COUNT; ++i) {
 
         // Sensor-Pins initialisieren (inkl. Pull-Down und IRQ)
-        if (!setupSensors(gpio)) {
-            logError("Sensor-Init fehlgeschlagen für GPIO %d\n", gpio);
-            initialized = false;    // Initialisierung fehlgeschlagen
+        if (setupSensors(sensorPins[i])) {
+            sensorHealthyMask |= static_cast<uint8_t>(1u << i);
+        } else {
+            LOG_ERROR(INIT, "Sensor-Init fehlgeschlagen für GPIO %d\n", sensorPins[i]);
         }
     }
 
+    // Eingeschränkter Betrieb: betriebsbereit, solange mindestens ein LED-Kanal funktioniert
+    initialized = ledHealthyMask != 0;
+    healthCheckNext = make_timeout_time_ms(HEALTH_CHECK_INTERVAL_MS);
+
     // Initialwerte für Statusarrays setzen
     currentLevel.fill(0);       // Alle LEDs aus
     targetLevel.fill(0);        // Alle Zielwerte auf 0 setzen
     fading.fill(false);         // Kein Fading aktiv
     ledState.fill(false);       // Alle LEDs aus
     lastTriggerTime.fill({});   // Letzte Triggerzeiten zurücksetzen
+    openSince.fill({});         // Öffnungszeitpunkte zurücksetzen
+    dimLevel.fill(PWM_WRAP);    // Volle Helligkeit, bis per Taster gedimmt wird
+
+    // Konfiguration (Sensor-Kanal-Matrix) aus dem Flash laden
+    loadConfig();
 
     // Debug-Ausgabe des Initialisierungsstatus
-    if (initialized) {
-        logDebug("CabinetLight Konstruktor abgeschlossen.\n");
+    if (!getFaultMask()) {
+        LOG_DEBUG(INIT, "CabinetLight Konstruktor abgeschlossen.\n");
     } else {
-        logError("CabinetLight Initialisierung unvollständig!\n");
+        LOG_ERROR(INIT, "CabinetLight Initialisierung unvollständig, eingeschränkter Betrieb (LED 0x%02x, Sensor 0x%02x)\n",
+                  getLedFaultMask(), getSensorFaultMask());
     }
+    updateStatusLed();
 }
 
 // Initialisiert einen LED-Pin für PWM-Betrieb
-bool CabinetLight::setupPwmLEDs(uint8_t gpio) {
+bool CabinetLight::setupPwmLEDs(uint8_t gpio, bool testBlink) {
 
     // Gültigkeit des Pins prüfen (nur GPIO 0-29 erlaubt)
     if (gpio > 29) {
-        logError("Ungültiger LED-GPIO: %d\n", gpio);
+        LOG_ERROR(PWM, "Ungültiger LED-GPIO: %d\n", gpio);
         return false;
     }
     
-    logDebug("setupPwmLEDs: Konfiguriere PWM für GPIO %d\n", gpio);
+    LOG_DEBUG(PWM, "setupPwmLEDs: Konfiguriere PWM für GPIO %d\n", gpio);
     
     gpio_init(gpio);                        // GPIO initialisieren
     gpio_set_function(gpio, GPIO_FUNC_PWM); // Kein Pull-Up/Down (MOSFET-Gate wird durch PWM gesteuert)
@@ -125,6 +147,9 @@ bool CabinetLight::setupPwmLEDs(uint8_t gpio) {
     pwm_set_gpio_level(gpio, 0);                // LED aus
     pwm_set_enabled(slice, true);               // PWM-Ausgang aktivieren
 
+    // Teilt sich der Kanal den Slice mit der Onboard-LED, übernimmt StatusLed TOP und Teiler (kein DMA-Atmen)
+    if (slice == pwm_gpio_to_slice_num(PICO_DEFAULT_LED_PIN)) StatusLed::refresh();
+
     // Statusarrays für diesen Kanal zurücksetzen
     auto it = std::find(ledPins.begin(), ledPins.end(), gpio);
 
@@ -132,15 +157,18 @@ bool CabinetLight::setupPwmLEDs(uint8_t gpio) {
     if (it != ledPins.end()) {
         // Index ermitteln
         size_t idx = std::distance(ledPins.begin(), it);
-        currentLevel[idx] = 0;  // LED aus
-        targetLevel[idx] = 0;   // Ziellevel auf 0
-        fading[idx] = false;    // Kein Fading aktiv
+        setCurrentLevel(idx, 0);    // LED aus
+        targetLevel[idx] = 0;       // Ziellevel auf 0
+        fading[idx] = false;        // Kein Fading aktiv
+        compositor.invalidate(idx, 0);  // Hardware steht auf 0, Ausgabe neu bestimmen
     }
 
-    // Kurzer Test: LED einmal an/aus
-    pwm_set_gpio_level(gpio, PWM_WRAP); // LED an
-    sleep_ms(PWM_TEST_DELAY_MS);        // kurze Pause
-    pwm_set_gpio_level(gpio, 0);        // LED aus
+    // Kurzer Test: LED einmal an/aus (nicht beim Wiederholungsversuch im laufenden Betrieb)
+    if (testBlink) {
+        pwm_set_gpio_level(gpio, PWM_WRAP); // LED an
+        sleep_ms(PWM_TEST_DELAY_MS);        // kurze Pause
+        pwm_set_gpio_level(gpio, 0);        // LED aus
+    }
     return true;
 }
 
@@ -149,11 +177,11 @@ bool CabinetLight::setupSensors(uint8_t gpio) {
 
     // Gültigkeit des Pins prüfen (nur GPIO 0-29 erlaubt)
     if (gpio > 29) {
-        logError("Ungültiger Sensor-GPIO: %d\n", gpio);
+        LOG_ERROR(INIT, "Ungültiger Sensor-GPIO: %d\n", gpio);
         return false;
     }
     
-    logDebug("setupSensors: Konfiguriere Sensor GPIO %d\n", gpio);
+    LOG_DEBUG(INIT, "setupSensors: Konfiguriere Sensor GPIO %d\n", gpio);
     
     gpio_init(gpio);                // GPIO initialisieren 
     gpio_set_dir(gpio, GPIO_IN);    // Als Eingang  
@@ -179,6 +207,8 @@ bool CabinetLight::setupSensors(uint8_t gpio) {
 // Wird vom Pico-SDK aufgerufen, um IRQs an die CabinetLight-Instanz weiterzuleiten
 void cabinet_gpio_callback(uint gpio, uint32_t events) {
     
+    LoadMeter::Scope load(LoadMeter::Bucket::IRQ);
+    TRACE_INSTANT(IRQ, "gpio");
     // Singleton-Instanz abrufen
     CabinetLight* inst = CabinetLight::getInstance();
     // Wenn die Instanz existiert, Callback aufrufen
@@ -198,10 +228,11 @@ void CabinetLight::fadeLed(uint gpio, bool on) {
     // Index ermitteln
     size_t idx = std::distance(ledPins.begin(), it);
     // Neues Ziellevel setzen
-    uint16_t newTarget = on ? PWM_WRAP : 0;
+    uint16_t newTarget = on ? dimLevel[idx] : 0;
     // Nur wenn sich das Ziellevel ändert, Fading aktivieren
     if (targetLevel[idx] != newTarget) {
         targetLevel[idx] = newTarget;   // Ziellevel setzen
+        if (!fading[idx]) fadeFracQ16[idx] = 0;
         fading[idx] = true; // Fading nur aktivieren, wenn sich das Ziellevel ändert
     }
 }
@@ -210,7 +241,7 @@ void CabinetLight::fadeLed(uint gpio, bool on) {
 // Wird von der freien Callback-Funktion aufgerufen
 void CabinetLight::gpioCallback(uint gpio, uint32_t events) {
 
-    logDebug("gpioCallback: GPIO %d, events=0x%08x\n", gpio, events);
+    LOG_DEBUG(IRQ, "gpioCallback: GPIO %d, events=0x%08x\n", gpio, events);
     // Singleton-Instanz abrufen
     CabinetLight* inst = getInstance();
     if (!inst) return;
@@ -223,9 +254,11 @@ void CabinetLight::onGpioIrq(uint gpio) {
     // Finde den Index des GPIO in der sensorPins-Liste
     for (int i = 0; i < static_cast<int>(DEV_COUNT); ++i) {
         if (sensorPins[i] == gpio) {
-            logDebug("onGpioIrq: matched sensor index %d (gpio %d)\n", i, gpio);
-            // Setze das Pending-Bit für diesen Sensor (atomar)
+            LOG_DEBUG(IRQ, "onGpioIrq: matched sensor index %d (gpio %d)\n", i, gpio);
+            // Flanke zählen, dann das Pending-Bit für diesen Sensor setzen (atomar)
+            irqEdgeCount[i].fetch_add(1, std::memory_order_relaxed);
             pendingMask.fetch_or(static_cast<uint8_t>(1u << i));
+            __sev();    // Hauptschleife aus WFE wecken
             break;
         }
     }
@@ -233,79 +266,815 @@ void CabinetLight::onGpioIrq(uint gpio) {
 
 // Hauptverarbeitung: prüft Sensorereignisse, Polling und steuert das Fading
 void CabinetLight::process() {
-    // 1. IRQ-Events abarbeiten (pendingMask wird atomar zurückgesetzt)
-    uint8_t pending = pendingMask.exchange(0);
+    {
+        LoadMeter::Scope load(LoadMeter::Bucket::SENSOR);
+        TRACE_SCOPE(MAIN, "sensors");
+        sensorStage();
+    }
+    Supervisor::checkIn(Supervisor::Task::SENSOR);
+    renderStage();
+    Supervisor::checkIn(Supervisor::Task::RENDER);
+}
+
+// Ereignisstufe von process(): Sensoren, Entprellung, Auslöser, Matrix, Zeitsteuerung
+void CabinetLight::sensorStage() {
+    // 1. IRQ-Events abarbeiten (pendingMask wird atomar zurückgesetzt): Flanken merken
+    uint8_t pending = pendingMask.exchange(0) & sensorHealthyMask;
+    uint8_t sensors = sensorActiveMask;
     if (pending) {
+        absolute_time_t now = get_absolute_time();
         for (int i = 0; i < static_cast<int>(DEV_COUNT); ++i) {
             if (!(pending & (1u << i))) continue;
-            absolute_time_t now = get_absolute_time();
-            // Entprellung: nur behandeln, wenn genug Zeit vergangen ist
-            if (absolute_time_diff_us(lastTriggerTime[i], now) < DEBOUNCE_MS * 1000) continue;
-            lastTriggerTime[i] = now;
-            bool gpio_state = gpio_get(sensorPins[i]);
-            // Sensorlogik: active-low oder active-high
-            bool door_open = sensorActiveLow[i] ? (gpio_state == 0) : (gpio_state != 0);
-            logDebug("process: sensor %d gpio=%d state=%d door_open=%d ledState=%d\n", i, sensorPins[i], gpio_state, door_open, ledState[i]);
-            if (door_open && !ledState[i]) {
-                // Tür wurde geöffnet, LED einschalten (faden)
-                logDebug("process: opening detected on sensor %d -> fade on\n", i);
-                fadeLed(ledPins[i], true);
-                ledState[i] = true;
-            } else if (!door_open && ledState[i]) {
-                // Tür wurde geschlossen, LED ausschalten (faden)
-                logDebug("process: closing detected on sensor %d -> fade off\n", i);
-                fadeLed(ledPins[i], false);
-                ledState[i] = false;
-            }
+            ++consumedEdgeCount[i];
+            registerEdge(i, now);
         }
     }
 
     // 2. Polling-Fallback: prüft regelmäßig die Sensor-GPIOs (falls IRQs verloren gehen)
     if (pollingFallback) {
         for (int i = 0; i < static_cast<int>(DEV_COUNT); ++i) {
+            if (!(sensorHealthyMask & (1u << i))) continue;
             bool raw = gpio_get(sensorPins[i]) != 0;
             if (raw != lastRawState[i]) {
-                absolute_time_t now = get_absolute_time();
-                // Entprellung auch beim Polling beachten
-                if (absolute_time_diff_us(lastTriggerTime[i], now) >= DEBOUNCE_MS * 1000) {
-                    lastTriggerTime[i] = now;
-                    logDebug("[POLL] sensor %d raw=%d (changed)\n", i, raw);
-                    bool door_open = sensorActiveLow[i] ? (raw == 0) : (raw != 0);
-                    logDebug("[POLL] sensor %d door_open=%d\n", i, door_open);
-                    if (door_open && !ledState[i]) {
-                        fadeLed(ledPins[i], true);
-                        ledState[i] = true;
-                    } else if (!door_open && ledState[i]) {
-                        fadeLed(ledPins[i], false);
-                        ledState[i] = false;
-                    }
-                }
+                LOG_DEBUG(SENSOR, "[POLL] sensor %d raw=%d (changed)\n", i, raw);
+                registerEdge(i, get_absolute_time());
             }
             lastRawState[i] = raw;
         }
     }
 
-    // 3. Fading-Logik: aktuelles PWM-Level schrittweise ans Ziellevel anpassen
+    // 2b. Entprellung: Pegel übernehmen, die seit der letzten Flanke DEBOUNCE_MS stabil sind
+    if (settleMask) settleSensors(sensors);
+
+    // 3. PIR-Haltezeiten: abgelaufene Bewegungsmelder deaktivieren
+    if (pirActiveMask) expirePirHolds(sensors);
+
+    // 3b. Taster: langer Druck startet die Dimmrampe
+    if (buttonHeldMask & ~rampMask) checkButtonHolds(sensors);
+
+    // 4. Sensor-Kanal-Matrix: einmal pro Ereignis-Batch auswerten (defekte Sensoren gelten als inaktiv)
+    sensors &= sensorHealthyMask;
+    if (sensors != sensorActiveMask) {
+        sensorActiveMask = sensors;
+        applySensorMask();
+    }
+
+    // Bestätigtes Vorglimmen erst jetzt auflösen, wenn feststeht, welche Kanäle eingeschaltet wurden
+    if (specConfirmMask) {
+        for (size_t i = 0; i < DEV_COUNT; ++i) {
+            if (specConfirmMask & (1u << i)) resolveSpeculation(i, true);
+        }
+        specConfirmMask = 0;
+    }
+
+    // 4a. Kanalzustand prüfen, defekte Kanäle erneut initialisieren
+    if (time_reached(healthCheckNext)) checkHealth();
+
+    // 4b. Nachleuchten: ein Zeitvergleich, bis die früheste Nachleucht-Zeit erreicht ist
+    if (afterglowMask && time_reached(afterglowNext)) expireAfterglow();
+
+    // 5. Langes Offenstehen: nach longOpenBreathMs in das Atmen wechseln
+    if (longOpenBreathMs) {
+        absolute_time_t now = get_absolute_time();
+        for (size_t i = 0; i < DEV_COUNT; ++i) {
+            if (!ledState[i] || fading[i] || ((animation.activeMask() | afterglowMask) & (1u << i))) continue;
+            if (absolute_time_diff_us(openSince[i], now) >= static_cast<int64_t>(longOpenBreathMs) * 1000) {
+                LOG_DEBUG(FADE, "process: channel %d open for %u ms -> breathe\n", i, longOpenBreathMs);
+                startAnimation(i, LightAnimation::BREATHE);
+            }
+        }
+    }
+
+}
+
+// Frame- und Ausgabestufe von process()
+void CabinetLight::renderStage() {
+    LoadMeter::Scope load(LoadMeter::Bucket::RENDER);
+    TRACE_SCOPE(MAIN, "render");
+
+    // 6. Frame-Rendering: Fading und Animationen nur zu Frame-Ticks mit fester Rate
+    uint32_t frames = renderer.takeFrames();
+    uint32_t frameStart = time_us_32();
+    if (frames) {
+        if (rampMask) stepRamps();
+        stepFades(frames);
+        processAnimations();
+    }
+
+    // 7. Ausgabestufe: nur wenn sich ein Pegel geändert hat
+    renderOutputs();
+    if (frames) renderer.frameDone(frameStart);
+
+    // 8. Adaptive Bildrate: Frame-Timer nur, solange sich ein Kanal zeitlich ändert
+    if (isAnimating()) {
+        renderer.start();
+    } else {
+        renderer.stop();
+    }
+}
+
+// Fading-Logik: aktuelles PWM-Level ans Ziellevel anpassen
+// frames > 1 holt verpasste Frames nach, damit die Fading-Dauer unabhängig vom Schleifentakt bleibt.
+// Die Schrittweite je Kanal und Richtung ist vorberechnet (Q16), der Nachkommaanteil wird mitgeführt.
+void CabinetLight::stepFades(uint32_t frames) {
     for (size_t i = 0; i < DEV_COUNT; ++i) {
         if (!fading[i]) continue;
         uint32_t cur = currentLevel[i];
         uint32_t tgt = targetLevel[i];
         if (cur == tgt) { fading[i] = false; continue; }
+        uint64_t stepQ16 = static_cast<uint64_t>(cur < tgt ? fadeInStepQ16[i] : fadeOutStepQ16[i]) * frames + fadeFracQ16[i];
+        fadeFracQ16[i] = static_cast<uint16_t>(stepQ16);
+        uint32_t step = static_cast<uint32_t>(std::min<uint64_t>(stepQ16 >> 16, PWM_WRAP));
         if (cur < tgt) {
-            uint32_t next = cur + FADE_STEP;
+            uint32_t next = cur + step;
             if (next > tgt) next = tgt;
-            currentLevel[i] = static_cast<uint16_t>(next);
+            setCurrentLevel(i, static_cast<uint16_t>(next));
         } else {
-            uint32_t next = cur > FADE_STEP ? cur - FADE_STEP : 0;
-            currentLevel[i] = static_cast<uint16_t>(next);
+            uint32_t next = cur > tgt + step ? cur - step : tgt;
+            setCurrentLevel(i, static_cast<uint16_t>(next));
         }
-        // PWM-Level setzen (LED heller/dunkler)
-        pwm_set_gpio_level(ledPins[i], currentLevel[i]);
         if (currentLevel[i] == targetLevel[i]) fading[i] = false;
-        sleep_ms(FADING_STEP_MS); // Fading-Schritt-Delay jetzt als constexpr
     }
 }
 
+// Gibt zurück, ob sich ein Kanal zeitlich ändert (Fading oder laufende Animation)
+bool CabinetLight::isAnimating() const {
+    if (animation.animatingMask() || rampMask) return true;
+    for (bool f : fading) {
+        if (f) return true;
+    }
+    return false;
+}
+
+// Nächster Zeitpunkt, zu dem process() ohne IRQ oder Frame-Tick aufgerufen werden muss
+absolute_time_t CabinetLight::nextDeadline() const {
+    absolute_time_t deadline = at_the_end_of_time;
+
+    // Polling-Fallback benötigt einen regelmäßigen Aufruf
+    if (pollingFallback) deadline = make_timeout_time_ms(POLL_INTERVAL_MS);
+
+    // Ablauf der PIR-Haltezeiten
+    for (size_t s = 0; s < DEV_COUNT; ++s) {
+        if (pirActiveMask & (1u << s)) deadline = absolute_time_min(deadline, pirHoldUntil[s]);
+    }
+
+    // Ende der Entprellfenster
+    for (size_t s = 0; s < DEV_COUNT; ++s) {
+        if (settleMask & (1u << s)) deadline = absolute_time_min(deadline, delayed_by_ms(lastTriggerTime[s], DEBOUNCE_MS));
+    }
+
+    // Erkennung des langen Tasterdrucks
+    for (size_t s = 0; s < DEV_COUNT; ++s) {
+        if ((buttonHeldMask & ~rampMask) & (1u << s)) {
+            deadline = absolute_time_min(deadline, delayed_by_ms(buttonPressedAt[s], LONG_PRESS_MS));
+        }
+    }
+
+    // Ende des Nachleuchtens
+    if (afterglowMask) deadline = absolute_time_min(deadline, afterglowNext);
+
+    // Zyklische Prüfung des Kanalzustands
+    deadline = absolute_time_min(deadline, healthCheckNext);
+
+    // Übergang in das Atmen bei langem Offenstehen
+    if (longOpenBreathMs) {
+        for (size_t i = 0; i < DEV_COUNT; ++i) {
+            if (!ledState[i] || ((animation.activeMask() | afterglowMask) & (1u << i))) continue;
+            deadline = absolute_time_min(deadline, delayed_by_ms(openSince[i], longOpenBreathMs));
+        }
+    }
+    return deadline;
+}
+
+// Dispatch-Tabelle der Auslöserarten (Index = TriggerType)
+const CabinetLight::TriggerHandler CabinetLight::TRIGGER_HANDLERS[] = {
+    &CabinetLight::triggerReed,     // TriggerType::REED
+    &CabinetLight::triggerPir,      // TriggerType::PIR
+    &CabinetLight::triggerButton    // TriggerType::BUTTON
+};
+
+// Übersetzt einen entprellten Sensorpegel in den Sensorzustand
+// Reedkontakte (Standard) werden ohne Tabellenzugriff direkt behandelt
+void CabinetLight::applyTrigger(size_t sensor, bool active, uint8_t& sensors) {
+    uint8_t bit = static_cast<uint8_t>(1u << sensor);
+    if (!(nonReedMask & bit)) {
+        sensors = active ? (sensors | bit) : (sensors & static_cast<uint8_t>(~bit));
+        return;
+    }
+    (this->*TRIGGER_HANDLERS[config.triggerType[sensor]])(sensor, active, sensors);
+}
+
+// Reedkontakt: Pegel entspricht dem Türzustand
+void CabinetLight::triggerReed(size_t sensor, bool active, uint8_t& sensors) {
+    uint8_t bit = static_cast<uint8_t>(1u << sensor);
+    sensors = active ? (sensors | bit) : (sensors & static_cast<uint8_t>(~bit));
+}
+
+// Bewegungsmelder: jede aktive Flanke (re)startet die Haltezeit, inaktive Flanken werden ignoriert
+void CabinetLight::triggerPir(size_t sensor, bool active, uint8_t& sensors) {
+    if (!active) return;
+    uint8_t bit = static_cast<uint8_t>(1u << sensor);
+    pirHoldUntil[sensor] = make_timeout_time_ms(config.pirHoldS[sensor] * 1000u);
+    pirActiveMask |= bit;
+    sensors |= bit;
+    LOG_DEBUG(SENSOR, "process: PIR %d retrigger, hold %u s\n", sensor, config.pirHoldS[sensor]);
+}
+
+// Taster: der Druck wird nur vermerkt, entschieden wird beim Loslassen bzw. nach LONG_PRESS_MS
+void CabinetLight::triggerButton(size_t sensor, bool active, uint8_t& sensors) {
+    uint8_t bit = static_cast<uint8_t>(1u << sensor);
+    if (!active) {
+        releaseButton(sensor, sensors);
+        return;
+    }
+    if (buttonHeldMask & bit) return;   // Bereits gedrückt
+    buttonHeldMask |= bit;
+    buttonPressedAt[sensor] = get_absolute_time();
+}
+
+// Loslassen: kurzer Druck schaltet um, nach einer Dimmrampe wird die erreichte Helligkeit gemerkt
+void CabinetLight::releaseButton(size_t sensor, uint8_t& sensors) {
+    uint8_t bit = static_cast<uint8_t>(1u << sensor);
+    if (!(buttonHeldMask & bit)) return;
+    buttonHeldMask &= static_cast<uint8_t>(~bit);
+
+    if (!(rampMask & bit)) {
+        sensors ^= bit;
+        return;
+    }
+    rampMask &= static_cast<uint8_t>(~bit);
+    for (size_t c = 0; c < DEV_COUNT; ++c) {
+        if (!(config.sensorChannelMap[sensor] & (1u << c)) || !ledState[c]) continue;
+        dimLevel[c] = currentLevel[c];
+        LOG_DEBUG(FADE, "process: button %d channel %d dim level %u\n", sensor, c, dimLevel[c]);
+    }
+}
+
+// Langer Druck: schaltet die zugeordneten Kanäle ein und startet die Dimmrampe
+// Ein verlorenes Loslass-Ereignis (Prellen innerhalb DEBOUNCE_MS) wird über den GPIO-Pegel erkannt
+void CabinetLight::checkButtonHolds(uint8_t& sensors) {
+    for (size_t s = 0; s < DEV_COUNT; ++s) {
+        uint8_t bit = static_cast<uint8_t>(1u << s);
+        if (!(buttonHeldMask & bit) || (rampMask & bit)) continue;
+        if (!readSensor(s)) {
+            releaseButton(s, sensors);
+            continue;
+        }
+        if (!time_reached(delayed_by_ms(buttonPressedAt[s], LONG_PRESS_MS))) continue;
+
+        // Richtung: aus -> heller; an den Grenzen vom Anschlag weg, sonst abwechselnd
+        uint16_t level = 0;
+        for (size_t c = 0; c < DEV_COUNT; ++c) {
+            if ((config.sensorChannelMap[s] & (1u << c)) && ledState[c]) level = std::max(level, currentLevel[c]);
+        }
+        if (!(sensors & bit) || level <= RAMP_MIN_LEVEL) {
+            rampUpMask |= bit;
+        } else if (level >= PWM_WRAP) {
+            rampUpMask &= static_cast<uint8_t>(~bit);
+        } else {
+            rampUpMask ^= bit;
+        }
+
+        sensors |= bit;
+        rampMask |= bit;
+        rampStartUs[s] = rampLastUs[s] = time_us_32();
+        rampRemainder[s] = 0;
+        LOG_DEBUG(FADE, "process: button %d long press -> ramp %s\n", s, (rampUpMask & bit) ? "up" : "down");
+    }
+}
+
+// Dimmrampe: Geschwindigkeit wächst linear mit der Haltedauer, der Weg ergibt sich aus der
+// vergangenen Zeit seit dem letzten Schritt (nicht aus der Anzahl der Frames)
+void CabinetLight::stepRamps() {
+    uint32_t nowUs = time_us_32();
+    for (size_t s = 0; s < DEV_COUNT; ++s) {
+        uint8_t bit = static_cast<uint8_t>(1u << s);
+        if (!(rampMask & bit)) continue;
+
+        // Loslassen ohne (entprelltes) Ereignis: Rampe beenden
+        if (!readSensor(s)) {
+            uint8_t sensors = sensorActiveMask;
+            releaseButton(s, sensors);
+            continue;
+        }
+
+        uint32_t heldMs = (nowUs - rampStartUs[s]) / 1000u;
+        uint32_t rate = std::min(RAMP_BASE_RATE + RAMP_ACCEL * heldMs / 1000u, RAMP_MAX_RATE);
+        uint32_t dtUs = std::min(nowUs - rampLastUs[s], 100000u);  // Lange Pausen begrenzen
+        rampLastUs[s] = nowUs;
+        rampRemainder[s] += rate * dtUs;
+        uint32_t delta = rampRemainder[s] / 1000000u;
+        if (!delta) continue;
+        rampRemainder[s] -= delta * 1000000u;
+
+        for (size_t c = 0; c < DEV_COUNT; ++c) {
+            if (!(config.sensorChannelMap[s] & (1u << c)) || !ledState[c]) continue;
+            int32_t level = currentLevel[c];
+            level += (rampUpMask & bit) ? static_cast<int32_t>(delta) : -static_cast<int32_t>(delta);
+            level = std::clamp<int32_t>(level, RAMP_MIN_LEVEL, PWM_WRAP);
+            setCurrentLevel(c, static_cast<uint16_t>(level));
+            targetLevel[c] = currentLevel[c];   // Rampe übernimmt ein laufendes Fading
+            fading[c] = false;
+        }
+    }
+}
+
+// Liest den aktuellen Pegel eines Sensors nach Polarity
+bool CabinetLight::readSensor(size_t sensor) const {
+    bool raw = gpio_get(sensorPins[sensor]) != 0;
+    return sensorActiveLow[sensor] ? !raw : raw;
+}
+
+// LED-Kanal gesund: gültiger Pin im PWM-Modus
+bool CabinetLight::verifyLed(size_t idx) const {
+    uint8_t gpio = ledPins[idx];
+    return gpio <= 29 && gpio_get_function(gpio) == GPIO_FUNC_PWM;
+}
+
+// Sensor gesund: gültiger Pin als SIO-Eingang
+bool CabinetLight::verifySensor(size_t idx) const {
+    uint8_t gpio = sensorPins[idx];
+    return gpio <= 29 && gpio_get_function(gpio) == GPIO_FUNC_SIO && !gpio_is_dir_out(gpio);
+}
+
+// Gesunde Kanäle prüfen, defekte neu initialisieren; Statusanzeige bei Änderungen nachführen
+void CabinetLight::checkHealth() {
+    healthCheckNext = make_timeout_time_ms(HEALTH_CHECK_INTERVAL_MS);
+    uint8_t ledBefore = ledHealthyMask;
+    uint8_t sensorBefore = sensorHealthyMask;
+
+    for (size_t i = 0; i < DEV_COUNT; ++i) {
+        uint8_t bit = static_cast<uint8_t>(1u << i);
+        if (ledHealthyMask & bit) {
+            if (!verifyLed(i)) {
+                ledHealthyMask &= ~bit;
+                LOG_ERROR(PWM, "Kanal %d: LED-GPIO %d nicht mehr im PWM-Modus\n", static_cast<int>(i), ledPins[i]);
+            }
+        } else if (setupPwmLEDs(ledPins[i], false)) {
+            ledHealthyMask |= bit;
+            LOG_INFO(PWM, "Kanal %d: LED wieder betriebsbereit\n", static_cast<int>(i));
+            if (ledState[i]) fadeLed(ledPins[i], true);     // Tür offen: wieder einblenden
+        }
+
+        if (sensorHealthyMask & bit) {
+            if (!verifySensor(i)) {
+                sensorHealthyMask &= ~bit;
+                LOG_ERROR(SENSOR, "Sensor %d: GPIO %d nicht mehr als Eingang konfiguriert\n", static_cast<int>(i), sensorPins[i]);
+            }
+        } else if (setupSensors(sensorPins[i])) {
+            sensorHealthyMask |= bit;
+            lastRawState[i] = gpio_get(sensorPins[i]) != 0;
+            LOG_INFO(SENSOR, "Sensor %d wieder betriebsbereit\n", static_cast<int>(i));
+        }
+    }
+
+    if (ledHealthyMask != ledBefore || sensorHealthyMask != sensorBefore) updateStatusLed();
+}
+
+// Fehlercode: LED-Kanal c = c + 1 Impulse, Sensor s = s + 1 + DEV_COUNT Impulse (niedrigster Fehler zuerst)
+void CabinetLight::updateStatusLed() {
+    uint8_t code = 0;
+    uint8_t ledFaults = getLedFaultMask();
+    uint8_t sensorFaults = getSensorFaultMask();
+    if (ledFaults) {
+        code = static_cast<uint8_t>(__builtin_ctz(ledFaults) + 1);
+    } else if (sensorFaults) {
+        code = static_cast<uint8_t>(__builtin_ctz(sensorFaults) + 1 + DEV_COUNT);
+    }
+    StatusLed::showErrorCode(code);
+}
+
+// Flankenzähler: Differenz aus IRQ-Flanken und abgeholten Ereignissen, ohne noch anstehende Bits
+CabinetLight::EdgeStats CabinetLight::getEdgeStats(size_t sensor) const {
+    EdgeStats stats = {};
+    if (sensor >= DEV_COUNT) return stats;
+    stats.consumedEdges = consumedEdgeCount[sensor];
+    bool waiting = pendingMask.load(std::memory_order_relaxed) & (1u << sensor);
+    stats.irqEdges = irqEdgeCount[sensor].load(std::memory_order_relaxed);
+    uint32_t handled = stats.consumedEdges + (waiting ? 1u : 0u);
+    stats.coalesced = stats.irqEdges > handled ? stats.irqEdges - handled : 0;
+    return stats;
+}
+
+// Flanke: Entprellfenster (neu) starten; die erste Flanke einer Türöffnung lässt die Kanäle vorglimmen
+void CabinetLight::registerEdge(size_t sensor, absolute_time_t now) {
+    uint8_t bit = static_cast<uint8_t>(1u << sensor);
+    lastTriggerTime[sensor] = now;
+    settleMask |= bit;
+    if (edgesInWindow[sensor] < UINT8_MAX) ++edgesInWindow[sensor];
+
+    if (!speculativeLight || (specMask & bit) || (nonReedMask & bit) || (sensorLevelMask & bit)) return;
+    if (!readSensor(sensor)) return;
+
+    // Nur ausgeschaltete Kanäle glimmen vor
+    uint8_t channels = 0;
+    for (size_t c = 0; c < DEV_COUNT; ++c) {
+        if ((config.sensorChannelMap[sensor] & (1u << c)) && !ledState[c]) channels |= static_cast<uint8_t>(1u << c);
+    }
+    if (!channels) return;
+
+    for (size_t c = 0; c < DEV_COUNT; ++c) {
+        if (channels & (1u << c)) compositor.setLevel(c, LightCompositor::Layer::SPECULATIVE, SPECULATIVE_LEVEL);
+    }
+    specChannels[sensor] = channels;
+    specStartUs[sensor] = time_us_32();
+    specMask |= bit;
+    ++specStats.starts;
+}
+
+// Entprellung: ein Pegel gilt, wenn seit der letzten Flanke DEBOUNCE_MS vergangen sind
+void CabinetLight::settleSensors(uint8_t& sensors) {
+    absolute_time_t now = get_absolute_time();
+    for (size_t i = 0; i < DEV_COUNT; ++i) {
+        uint8_t bit = static_cast<uint8_t>(1u << i);
+        if (!(settleMask & bit)) continue;
+        if (absolute_time_diff_us(lastTriggerTime[i], now) < DEBOUNCE_MS * 1000) continue;
+        settleMask &= static_cast<uint8_t>(~bit);
+
+        bool active = readSensor(i);
+        bool changed = active != ((sensorLevelMask & bit) != 0);
+        if (specMask & bit) {
+            if (active) {
+                specConfirmMask |= bit;         // Auflösung nach der Matrix (sensorStage, 4)
+            } else {
+                resolveSpeculation(i, false);
+            }
+        }
+
+        // Alle Flanken des Fensters außer der, die den Zustand wechselt, waren Prellen
+        uint32_t bounces = edgesInWindow[i] - (changed ? 1u : 0u);
+        edgesInWindow[i] = 0;
+        if (bounces) eventStats.recordBounces(i, bounces);
+        if (!changed) continue;
+
+        sensorLevelMask ^= bit;
+        LOG_DEBUG(SENSOR, "process: sensor %d gpio=%d active=%d\n", i, sensorPins[i], active);
+        applyTrigger(i, active, sensors);
+    }
+}
+
+// Vorglimmen beenden: eingeschaltete Kanäle faden ab dem Vorglimm-Pegel weiter,
+// alle anderen (Prellen oder Kanal bleibt aus) geben die Ebene ohne weiteres Fading frei
+void CabinetLight::resolveSpeculation(size_t sensor, bool confirmed) {
+    uint8_t bit = static_cast<uint8_t>(1u << sensor);
+    specMask &= static_cast<uint8_t>(~bit);
+
+    // Kanäle, die ein anderer Sensor noch vorglimmen lässt, bleiben unverändert
+    uint8_t others = 0;
+    for (size_t s = 0; s < DEV_COUNT; ++s) {
+        if (specMask & (1u << s)) others |= specChannels[s];
+    }
+
+    for (size_t c = 0; c < DEV_COUNT; ++c) {
+        if (!(specChannels[sensor] & (1u << c)) || (others & (1u << c))) continue;
+        if (confirmed && ledState[c] && currentLevel[c] < SPECULATIVE_LEVEL) {
+            setCurrentLevel(c, SPECULATIVE_LEVEL);
+            if (targetLevel[c] != currentLevel[c]) fading[c] = true;
+        }
+        compositor.release(c, LightCompositor::Layer::SPECULATIVE);
+    }
+
+    if (confirmed) {
+        ++specStats.commits;
+        specStats.gainUsTotal += time_us_32() - specStartUs[sensor];
+    } else {
+        ++specStats.rollbacks;
+        LOG_DEBUG(SENSOR, "process: sensor %d bounce, pre-light rolled back\n", sensor);
+    }
+}
+
+// Aktiviert oder deaktiviert das spekulative Vorglimmen
+void CabinetLight::setSpeculativeLight(bool enable) {
+    speculativeLight = enable;
+    logInfo("Vorglimmen %s\n", enable ? "aktiviert" : "deaktiviert");
+}
+
+// Deaktiviert Bewegungsmelder, deren Haltezeit abgelaufen ist
+void CabinetLight::expirePirHolds(uint8_t& sensors) {
+    for (size_t s = 0; s < DEV_COUNT; ++s) {
+        uint8_t bit = static_cast<uint8_t>(1u << s);
+        if (!(pirActiveMask & bit) || !time_reached(pirHoldUntil[s])) continue;
+        pirActiveMask &= static_cast<uint8_t>(~bit);
+        sensors &= static_cast<uint8_t>(~bit);
+        LOG_DEBUG(SENSOR, "process: PIR %d hold expired\n", s);
+    }
+}
+
+// Setzt die Auslöserart eines Sensors
+void CabinetLight::setTriggerType(size_t sensor, TriggerType type, uint16_t holdS) {
+    if (sensor >= DEV_COUNT || static_cast<size_t>(type) >= TRIGGER_TYPE_COUNT) {
+        logError("setTriggerType: ungültiger Sensor %d oder Typ %d\n", sensor, static_cast<int>(type));
+        return;
+    }
+    config.triggerType[sensor] = static_cast<uint8_t>(type);
+    config.pirHoldS[sensor] = holdS;
+
+    // Zustand des Sensors neu beginnen (keine offene Haltezeit, kein umgeschalteter Taster)
+    uint8_t bit = static_cast<uint8_t>(1u << sensor);
+    pirActiveMask &= static_cast<uint8_t>(~bit);
+    buttonHeldMask &= static_cast<uint8_t>(~bit);
+    rampMask &= static_cast<uint8_t>(~bit);
+    sensorActiveMask &= static_cast<uint8_t>(~bit);
+    applyConfig();
+}
+
+// Wertet die Sensor-Kanal-Matrix für den aktuellen Sensorzustand aus
+// Ein Durchlauf über alle Kanäle: OR = ein zugeordneter Sensor aktiv, AND = alle zugeordneten Sensoren aktiv
+void CabinetLight::applySensorMask() {
+    uint8_t glowBefore = afterglowMask;
+    for (size_t c = 0; c < DEV_COUNT; ++c) {
+        uint8_t bit = static_cast<uint8_t>(1u << c);
+        uint8_t mapped = channelSensorMask[c];
+        uint8_t hit = sensorActiveMask & mapped;
+        bool on = (config.channelAndMask & bit) ? (mapped && hit == mapped) : (hit != 0);
+
+        // Erneutes Öffnen im Nachleuchten: Licht ist noch an, nur das Nachleuchten beenden
+        if (on && (afterglowMask & bit)) {
+            afterglowMask &= static_cast<uint8_t>(~bit);
+            stopAnimation(c);                   // Ruhiges Licht; das Atmen beginnt erst nach erneutem Offenstehen
+            openSince[c] = get_absolute_time();
+            eventStats.recordOpen(c);
+            LOG_DEBUG(SENSOR, "process: channel %d reopened, afterglow cancelled\n", c);
+            continue;
+        }
+        if (on == ledState[c] || (afterglowMask & bit)) continue;
+
+        // Schließen mit Nachleuchten: Ausblenden erst nach Ablauf der Zeit
+        if (!on) eventStats.recordClose(c, static_cast<uint32_t>(absolute_time_diff_us(openSince[c], get_absolute_time()) / 1000));
+        if (!on && config.afterglowS[c]) {
+            afterglowMask |= bit;
+            afterglowUntil[c] = make_timeout_time_ms(config.afterglowS[c] * 1000u);
+            stopAnimation(c);                   // Atmen bei langem Offenstehen endet mit dem Schließen
+            LOG_DEBUG(FADE, "process: channel %d closed -> afterglow %u s\n", c, config.afterglowS[c]);
+            continue;
+        }
+
+        LOG_DEBUG(SENSOR, "process: channel %d sensors=0x%02x -> fade %s\n", c, sensorActiveMask, on ? "on" : "off");
+        setChannelState(c, on);
+        if (on) eventStats.recordOpen(c);
+    }
+    if (afterglowMask != glowBefore) updateAfterglowNext();
+}
+
+// Schaltet Kanäle mit abgelaufenem Nachleuchten aus
+void CabinetLight::expireAfterglow() {
+    for (size_t c = 0; c < DEV_COUNT; ++c) {
+        uint8_t bit = static_cast<uint8_t>(1u << c);
+        if (!(afterglowMask & bit) || !time_reached(afterglowUntil[c])) continue;
+        afterglowMask &= static_cast<uint8_t>(~bit);
+        LOG_DEBUG(FADE, "process: channel %d afterglow expired -> fade off\n", c);
+        setChannelState(c, false);
+    }
+    updateAfterglowNext();
+}
+
+// Frühestes Ende aller laufenden Nachleucht-Zeiten
+void CabinetLight::updateAfterglowNext() {
+    afterglowNext = at_the_end_of_time;
+    for (size_t c = 0; c < DEV_COUNT; ++c) {
+        if (afterglowMask & (1u << c)) afterglowNext = absolute_time_min(afterglowNext, afterglowUntil[c]);
+    }
+}
+
+// Leitet die transponierte Matrix (Kanal -> Sensoren) aus der Konfiguration ab
+void CabinetLight::applyConfig() {
+    channelSensorMask.fill(0);
+    nonReedMask = 0;
+    for (size_t c = 0; c < DEV_COUNT; ++c) {
+        fadeInStepQ16[c] = fadeStepQ16(config.fadeInMs[c]);
+        fadeOutStepQ16[c] = fadeStepQ16(config.fadeOutMs[c]);
+    }
+    for (size_t s = 0; s < DEV_COUNT; ++s) {
+        // Ungültige Auslöserarten (z.B. aus fremden Konfigurationsdaten) als Reedkontakt behandeln
+        if (config.triggerType[s] >= TRIGGER_TYPE_COUNT) config.triggerType[s] = static_cast<uint8_t>(TriggerType::REED);
+        if (config.triggerType[s] != static_cast<uint8_t>(TriggerType::REED)) nonReedMask |= static_cast<uint8_t>(1u << s);
+
+        for (size_t c = 0; c < DEV_COUNT; ++c) {
+            if (config.sensorChannelMap[s] & (1u << c)) channelSensorMask[c] |= static_cast<uint8_t>(1u << s);
+        }
+    }
+    applySensorMask();
+}
+
+// Fading-Dauer über den vollen Bereich -> Schrittweite pro Frame (Q16); einzige Division des Fadings
+uint32_t CabinetLight::fadeStepQ16(uint16_t ms) {
+    if (ms == 0) return FADE_STEP_PER_FRAME << 16;
+    uint32_t frames = std::max<uint32_t>(ms, MIN_FADE_MS) * FRAME_RATE_HZ / 1000u;
+    return static_cast<uint32_t>((static_cast<uint64_t>(PWM_WRAP) << 16) / frames);
+}
+
+// Setzt die Fading-Dauer eines Kanals für Ein- und Ausblenden
+void CabinetLight::setChannelFade(size_t channel, uint16_t fadeInMs, uint16_t fadeOutMs) {
+    if (channel >= DEV_COUNT) {
+        logError("setChannelFade: ungültiger Kanal %d\n", channel);
+        return;
+    }
+    config.fadeInMs[channel] = fadeInMs;
+    config.fadeOutMs[channel] = fadeOutMs;
+    fadeInStepQ16[channel] = fadeStepQ16(fadeInMs);
+    fadeOutStepQ16[channel] = fadeStepQ16(fadeOutMs);
+}
+
+// Setzt die Nachleuchtdauer eines Kanals
+void CabinetLight::setChannelAfterglow(size_t channel, uint16_t seconds) {
+    if (channel >= DEV_COUNT) {
+        logError("setChannelAfterglow: ungültiger Kanal %d\n", channel);
+        return;
+    }
+    config.afterglowS[channel] = seconds;
+}
+
+// Ordnet einem Sensor die Kanäle zu, auf die er wirkt
+void CabinetLight::setSensorChannelMap(size_t sensor, uint8_t channelMask) {
+    if (sensor >= DEV_COUNT) {
+        logError("setSensorChannelMap: ungültiger Sensor %d\n", sensor);
+        return;
+    }
+    config.sensorChannelMap[sensor] = static_cast<uint8_t>(channelMask & ((1u << DEV_COUNT) - 1u));
+    applyConfig();
+}
+
+// Setzt die Verknüpfungsregel eines Kanals (OR/AND)
+void CabinetLight::setChannelRule(size_t channel, MapRule rule) {
+    if (channel >= DEV_COUNT) {
+        logError("setChannelRule: ungültiger Kanal %d\n", channel);
+        return;
+    }
+    uint8_t bit = static_cast<uint8_t>(1u << channel);
+    if (rule == MapRule::AND) {
+        config.channelAndMask |= bit;
+    } else {
+        config.channelAndMask &= static_cast<uint8_t>(~bit);
+    }
+    applyConfig();
+}
+
+// Lädt die Konfiguration aus dem Flash (Standardwerte, falls keine gültigen Daten vorliegen)
+bool CabinetLight::loadConfig() {
+    bool ok = ConfigStore::load(config);
+    if (ok) {
+        logInfo("Konfiguration aus Flash geladen.\n");
+    } else {
+        logInfo("Keine gültige Konfiguration im Flash, verwende Standardwerte.\n");
+    }
+    applyConfig();
+    return ok;
+}
+
+// Speichert die aktuelle Konfiguration im Flash
+bool CabinetLight::saveConfig() {
+    bool ok = ConfigStore::save(config);
+    if (!ok) logError("Konfiguration konnte nicht gespeichert werden!\n");
+    return ok;
+}
+
+// Schaltet einen Kanal nach einem Türereignis ein oder aus
+// Gemeinsamer Pfad für alle Sensorquellen (über die Sensor-Kanal-Matrix)
+void CabinetLight::setChannelState(size_t idx, bool on) {
+    fadeLed(ledPins[idx], on);
+    ledState[idx] = on;
+    if (on) {
+        openSince[idx] = get_absolute_time();   // Startpunkt für das Atmen bei langem Offenstehen
+    } else {
+        stopAnimation(idx);                     // Atmen o.ä. beenden, Fading übernimmt
+    }
+}
+
+// Wertet alle Animationen aus und schreibt die Ergebnisse in die jeweilige Ebene
+// Kanäle, deren Animation endet, geben ihre Ebene frei
+void CabinetLight::processAnimations() {
+    if (!animationMask && !animation.activeMask()) return;
+
+    std::array<uint16_t, DEV_COUNT> levels = animationLevel;
+    uint8_t active = animation.tick(to_ms_since_boot(get_absolute_time()), levels);
+    for (size_t i = 0; i < DEV_COUNT; ++i) {
+        uint8_t bit = static_cast<uint8_t>(1u << i);
+        if (active & bit) {
+            // Nur geänderte Pegel bzw. neu belegte Kanäle markieren
+            if (!(animationMask & bit) || levels[i] != animationLevel[i]) {
+                animationLevel[i] = levels[i];
+                levelDirtyMask |= bit;
+            }
+        } else if (animationMask & bit) {
+            levelDirtyMask |= bit;      // Animation beendet, Ebene freigeben
+        }
+    }
+    animationMask = active;
+}
+
+// Setzt den Fading-Pegel eines Kanals und markiert ihn bei Änderung als dirty
+void CabinetLight::setCurrentLevel(size_t idx, uint16_t level) {
+    if (currentLevel[idx] == level) return;
+    currentLevel[idx] = level;
+    levelDirtyMask |= static_cast<uint8_t>(1u << idx);
+}
+
+// Ausgabestufe: überträgt geänderte Pegel in die Ebenen und gibt sie aus
+// Ohne Änderungen seit dem letzten Durchlauf wird die Stufe komplett übersprungen
+void CabinetLight::renderOutputs() {
+    if (!levelDirtyMask && !compositor.dirtyMask()) return;
+
+    for (size_t i = 0; i < DEV_COUNT; ++i) {
+        uint8_t bit = static_cast<uint8_t>(1u << i);
+        if (!(levelDirtyMask & bit)) continue;
+        compositor.setLevel(i, LightCompositor::Layer::DOOR, currentLevel[i]);
+        if (animationMask & bit) {
+            compositor.setLevel(i, animationLayer[i], animationLevel[i]);
+        } else {
+            compositor.release(i, animationLayer[i]);
+        }
+    }
+    levelDirtyMask = 0;
+    commitOutputs();
+}
+
+// Commit-Stufe: verrechnet die Ebenen und schreibt nur geänderte Kanäle in die PWM-Hardware
+void CabinetLight::commitOutputs() {
+    uint8_t changed = compositor.compose(outputLevel);
+    for (size_t i = 0; i < DEV_COUNT; ++i) {
+        if (changed & ledHealthyMask & (1u << i)) pwm_set_gpio_level(ledPins[i], outputLevel[i]);
+    }
+
+    // Startabgleich: Zeitpunkt des ersten sichtbaren Lichts festhalten
+    if (bootLightMask & changed) {
+        for (size_t i = 0; i < DEV_COUNT; ++i) {
+            if (!((bootLightMask & changed) & (1u << i)) || !outputLevel[i]) continue;
+            bootStats.firstLightUs = time_us_32();
+            bootLightMask = 0;
+            LOG_INFO(INIT, "Startabgleich: erstes Licht nach %u us (Kanal %d)\n",
+                     static_cast<unsigned>(bootStats.firstLightUs), static_cast<int>(i));
+            break;
+        }
+    }
+}
+
+// Startet ein Keyframe-Programm auf einem Kanal (ab dem aktuell sichtbaren Pegel)
+bool CabinetLight::startAnimation(size_t channel, const LightAnimation::Program& program, uint32_t delayMs, LightCompositor::Layer layer) {
+    if (channel >= DEV_COUNT) {
+        logError("startAnimation: ungültiger Kanal %d\n", channel);
+        return false;
+    }
+
+    // Startpegel: bisheriger Ebenenwert, sonst sichtbarer Pegel (MULTIPLY startet neutral bei PWM_WRAP)
+    uint16_t startLevel = outputLevel[channel];
+    if ((animationMask & (1u << channel)) && animationLayer[channel] == layer) {
+        startLevel = animationLevel[channel];
+    } else if (compositor.getBlend(layer) == LightCompositor::Blend::MULTIPLY) {
+        startLevel = PWM_WRAP;
+    }
+
+    uint32_t startMs = to_ms_since_boot(get_absolute_time()) + delayMs;
+    if (!animation.start(channel, program, startLevel, startMs)) {
+        logError("startAnimation: Programm für Kanal %d ungültig\n", channel);
+        return false;
+    }
+
+    // Wechselt die Animation die Ebene, wird die alte Ebene freigegeben
+    if ((animationMask & (1u << channel)) && animationLayer[channel] != layer) {
+        compositor.release(channel, animationLayer[channel]);
+        animationMask &= static_cast<uint8_t>(~(1u << channel));
+    }
+    animationLayer[channel] = layer;
+    levelDirtyMask |= static_cast<uint8_t>(1u << channel);
+    return true;
+}
+
+// Stoppt die Animation eines Kanals; die nächste Ausgabestufe stellt den Fading-Pegel her
+void CabinetLight::stopAnimation(size_t channel) {
+    if (channel >= DEV_COUNT) return;
+    animation.stop(channel);
+    // Ebene sofort freigeben (renderOutputs()), auch wenn danach kein Frame mehr läuft
+    uint8_t bit = static_cast<uint8_t>(1u << channel);
+    if (animationMask & bit) {
+        animationMask &= static_cast<uint8_t>(~bit);
+        levelDirtyMask |= bit;
+    }
+}
+
+// Setzt eine manuelle Übersteuerung (höchste Priorität)
+void CabinetLight::setManualLevel(size_t channel, uint16_t level) {
+    if (channel >= DEV_COUNT) return;
+    compositor.setLevel(channel, LightCompositor::Layer::MANUAL, std::min(level, PWM_WRAP));
+}
+
+// Hebt die manuelle Übersteuerung eines Kanals auf
+void CabinetLight::clearManualLevel(size_t channel) {
+    compositor.release(channel, LightCompositor::Layer::MANUAL);
+}
+
+// Startet ein Programm versetzt auf allen Kanälen (Lauflicht)
+void CabinetLight::startChase(const LightAnimation::Program& program, uint32_t stepMs) {
+    for (size_t i = 0; i < DEV_COUNT; ++i) {
+        startAnimation(i, program, i * stepMs);
+    }
+}
+
+// Setzt die Dauer bis zum Atmen bei offener Tür (0 = aus)
+void CabinetLight::setLongOpenBreathing(uint32_t ms) {
+    longOpenBreathMs = ms;
+    logInfo("Atmen bei offener Tür %s (%u ms)\n", ms ? "aktiviert" : "deaktiviert", ms);
+}
+
 // Setzt neue LED-Pins und initialisiert PWM für diese
 // Kann zur Laufzeit aufgerufen werden, um die LED-Pinbelegung zu ändern
 bool CabinetLight::setLedPins(const std::array<uint8_t, DEV_COUNT>& pins) {
@@ -313,23 +1082,30 @@ bool CabinetLight::setLedPins(const std::array<uint8_t, DEV_COUNT>& pins) {
     // Pins auf Gültigkeit prüfen
     for (uint8_t g : pins) {
         if (g > 29) {
-            printf("[ERROR] Ungültiger LED-Pin: %d\n", g);
+            logError("Ungültiger LED-Pin: %d\n", g);
             ok = false;
         }
     }
     if (!ok) return false;
 
-    // Alte PWM-Kanäle deaktivieren
-    for (uint8_t g : ledPins) {
-        uint slice = pwm_gpio_to_slice_num(g);
+    // Alte PWM-Kanäle deaktivieren (nur initialisierte)
+    for (size_t i = 0; i < DEV_COUNT; ++i) {
+        if (!(ledHealthyMask & (1u << i))) continue;
+        uint slice = pwm_gpio_to_slice_num(ledPins[i]);
         pwm_set_enabled(slice, false);
     }
     ledPins = pins;
 
     // Neue PWM-Kanäle initialisieren
-    for (uint8_t g : ledPins) {
-        if (!setupPwmLEDs(g)) ok = false;
+    ledHealthyMask = 0;
+    for (size_t i = 0; i < DEV_COUNT; ++i) {
+        if (setupPwmLEDs(ledPins[i])) {
+            ledHealthyMask |= static_cast<uint8_t>(1u << i);
+        } else {
+            ok = false;
+        }
     }
+    updateStatusLed();
     return ok;
 }
 
@@ -340,7 +1116,7 @@ bool CabinetLight::setSensorPins(const std::array<uint8_t, DEV_COUNT>& pins) {
     // Pins auf Gültigkeit prüfen
     for (uint8_t g : pins) {
         if (g > 29) {
-            printf("[ERROR] Ungültiger Sensor-Pin: %d\n", g);
+            logError("Ungültiger Sensor-Pin: %d\n", g);
             ok = false;
         }
     }
@@ -353,9 +1129,15 @@ bool CabinetLight::setSensorPins(const std::array<uint8_t, DEV_COUNT>& pins) {
     sensorPins = pins;
 
     // Neue Sensoren initialisieren
-    for (uint8_t g : sensorPins) {
-        if (!setupSensors(g)) ok = false;
+    sensorHealthyMask = 0;
+    for (size_t i = 0; i < DEV_COUNT; ++i) {
+        if (setupSensors(sensorPins[i])) {
+            sensorHealthyMask |= static_cast<uint8_t>(1u << i);
+        } else {
+            ok = false;
+        }
     }
+    updateStatusLed();
     return ok;
 }
 
@@ -372,14 +1154,74 @@ void CabinetLight::runStartupTest() {
     for (size_t i = 0; i < DEV_COUNT; ++i) {
         uint8_t g = ledPins[i];
         logInfo("[TEST] Blink LED on GPIO %d\n", g);
-        pwm_set_gpio_level(g, PWM_WRAP); // LED an
+        compositor.setLevel(i, LightCompositor::Layer::STARTUP_TEST, PWM_WRAP); // LED an
+        commitOutputs();
         sleep_ms(STARTUP_LED_ON_MS);
-        pwm_set_gpio_level(g, 0);        // LED aus
+        compositor.setLevel(i, LightCompositor::Layer::STARTUP_TEST, 0);        // LED aus
+        commitOutputs();
         sleep_ms(STARTUP_LED_OFF_MS);
+        compositor.release(i, LightCompositor::Layer::STARTUP_TEST);            // Tür-Pegel wieder sichtbar
     }
+    commitOutputs();
     logInfo("[TEST] Startup LED test completed.\n");
 }
 
+// Startabgleich: alle Sensoren mit je einem gpio_get_all() abtasten; übereinstimmende Abtastungen gelten
+// als entprellt und schalten sofort, wechselnde Pegel gehen an die normale Entprellung
+bool CabinetLight::syncSensors() {
+    bootStats = {};
+    bootStats.sampleUs = time_us_32();
+
+    uint32_t pinMask = 0;
+    for (size_t i = 0; i < DEV_COUNT; ++i) {
+        if (sensorHealthyMask & (1u << i)) pinMask |= 1u << sensorPins[i];
+    }
+    uint32_t first = gpio_get_all() & pinMask;
+    uint32_t unstable = 0;
+    for (uint32_t n = 1; n < BOOT_SYNC_SAMPLES; ++n) {
+        sleep_us(BOOT_SYNC_INTERVAL_US);
+        unstable |= (gpio_get_all() & pinMask) ^ first;
+    }
+
+    absolute_time_t now = get_absolute_time();
+    uint8_t sensors = sensorActiveMask;
+    for (size_t i = 0; i < DEV_COUNT; ++i) {
+        uint8_t bit = static_cast<uint8_t>(1u << i);
+        if (!(sensorHealthyMask & bit)) continue;
+        uint32_t pin = 1u << sensorPins[i];
+        lastRawState[i] = (first & pin) != 0;
+        if (unstable & pin) {
+            bootStats.unsettledMask |= bit;
+            registerEdge(i, now);
+            continue;
+        }
+        bool active = sensorActiveLow[i] ? !lastRawState[i] : lastRawState[i];
+        if (active) bootStats.activeMask |= bit;
+        if (active == ((sensorLevelMask & bit) != 0)) continue;
+        sensorLevelMask ^= bit;
+        if (config.triggerType[i] == static_cast<uint8_t>(TriggerType::BUTTON)) continue;
+        applyTrigger(i, active, sensors);
+    }
+
+    // Sensor-Kanal-Matrix auswerten: setzt die Ziellevel, das Fading läuft ab dem nächsten Frame
+    sensors &= sensorHealthyMask;
+    if (sensors != sensorActiveMask) {
+        sensorActiveMask = sensors;
+        applySensorMask();
+    }
+    for (size_t c = 0; c < DEV_COUNT; ++c) {
+        if (ledState[c]) bootStats.channelMask |= static_cast<uint8_t>(1u << c);
+    }
+    bootLightMask = bootStats.channelMask & ledHealthyMask;
+    bootStats.settledUs = time_us_32();
+    if (bootLightMask) renderer.start();
+
+    LOG_INFO(INIT, "Startabgleich: Sensoren aktiv 0x%02x, unruhig 0x%02x, Kanäle 0x%02x (Abtastung %u us, Fading ab %u us)\n",
+             bootStats.activeMask, bootStats.unsettledMask, bootStats.channelMask,
+             static_cast<unsigned>(bootStats.sampleUs), static_cast<unsigned>(bootStats.settledUs));
+    return bootStats.channelMask != 0;
+}
+
 // Aktiviert oder deaktiviert das Polling-Fallback für Sensoren
 // Sollte nur bei Problemen mit IRQs aktiviert werden
 void CabinetLight::setPollingFallback(bool enable) {
@@ -392,29 +1234,14 @@ bool CabinetLight::getPollingFallback() const {
     return pollingFallback;
 }
 
-// Blinkt die Onboard-LED (z.B. Boot- oder Heartbeat-Anzeige)
-// Kann für Statusanzeigen verwendet werden
-void CabinetLight::blinkOnboardLed(int times, int on_ms, int off_ms) {
-    gpio_init(PICO_DEFAULT_LED_PIN);
-    gpio_set_dir(PICO_DEFAULT_LED_PIN, GPIO_OUT);
-    for (int i = 0; i < times; ++i) {
-        gpio_put(PICO_DEFAULT_LED_PIN, 1);
-        sleep_ms(on_ms);
-        gpio_put(PICO_DEFAULT_LED_PIN, 0);
-        sleep_ms(off_ms);
-    }
-}
-
-// Endlosschleife für Fehleranzeige (Onboard-LED schnelles Blinken)
+// Endlosschleife für Fehleranzeige (Onboard-LED schnelles Blinken über StatusLed)
 // Wird bei fatalen Fehlern aufgerufen und blockiert das System
 [[noreturn]] void CabinetLight::fatalErrorBlink() {
-    gpio_init(PICO_DEFAULT_LED_PIN);
-    gpio_set_dir(PICO_DEFAULT_LED_PIN, GPIO_OUT);
+    CrashReport::recordFatal();     // Für den Absturzbericht beim nächsten Start (z.B. nach Watchdog-Reset)
+    StatusLed::init();              // Falls noch nicht gestartet
+    StatusLed::showFatal();
     while (true) {
-        gpio_put(PICO_DEFAULT_LED_PIN, 1);
-        sleep_ms(100);
-        gpio_put(PICO_DEFAULT_LED_PIN, 0);
-        sleep_ms(100);
+        __wfi();                    // Timer-Interrupt der Muster-Engine weckt kurz auf
     }
 }
 
@@ -422,9 +1249,16 @@ void CabinetLight::blinkOnboardLed(int times, int on_ms, int off_ms) {
 // Statisches LogLevel-Flag (global für alle Instanzen)
 CabinetLight::LogLevel CabinetLight::logLevel = CabinetLight::LogLevel::INFO;
 
+// Teilsystem-Filter der LOG_*-Makros (Startwert passend zu LogLevel INFO und allen Teilsystemen)
+uint8_t CabinetLight::logTagMask = CabinetLight::LOG_TAG_ALL;
+uint8_t CabinetLight::logFilter[CabinetLight::LOG_LEVEL_COUNT] = {
+    CabinetLight::LOG_TAG_ALL, CabinetLight::LOG_TAG_ALL, CabinetLight::LOG_TAG_ALL, 0
+};
+
 // Setzt das globale LogLevel
 void CabinetLight::setLogLevel(LogLevel level) {
     logLevel = level;
+    updateLogFilter();
 }
 
 // Gibt das aktuelle LogLevel zurück
@@ -432,34 +1266,86 @@ CabinetLight::LogLevel CabinetLight::getLogLevel() {
     return logLevel;
 }
 
+// Setzt die Teilsystem-Maske der LOG_*-Makros
+void CabinetLight::setLogTagMask(uint8_t mask) {
+    logTagMask = mask & LOG_TAG_ALL;
+    updateLogFilter();
+}
+
+// Gibt die Teilsystem-Maske zurück
+uint8_t CabinetLight::getLogTagMask() {
+    return logTagMask;
+}
+
+// Filtertabelle: LogLevel l ist freigegeben, wenn l <= logLevel
+void CabinetLight::updateLogFilter() {
+    for (size_t l = 0; l < LOG_LEVEL_COUNT; ++l) {
+        logFilter[l] = (l <= static_cast<size_t>(logLevel)) ? logTagMask : 0;
+    }
+}
+
+// Meldung mit Präfix "[LEVEL][TAG] "; zuvor ggf. Zusammenfassung der unterdrückten Meldungen
+void CabinetLight::logTagged(LogLevel level, LogTag tag, uint32_t suppressed, const char* fmt, ...) {
+    static const char* const levelNames[LOG_LEVEL_COUNT] = {"ERROR", "WARN", "INFO", "DEBUG"};
+    static const char* const tagNames[LOG_TAG_COUNT] = {"IRQ", "SENSOR", "FADE", "PWM", "INIT", "SYS"};
+    char prefix[20];
+    LogFormat::format(prefix, sizeof(prefix), "[%s][%s] ", levelNames[static_cast<size_t>(level)],
+                      tagNames[static_cast<size_t>(tag)]);
+    if (suppressed) {
+        logPrefixed(prefix, "%u messages suppressed\n", static_cast<unsigned>(suppressed));
+    }
+    va_list args; va_start(args, fmt); vlog(prefix, fmt, args); va_end(args);
+}
+
+// Gemeinsame Ausgabe: Formatierung mit LogFormat in einen Stack-Puffer (IRQ-fest), danach eine stdio-Ausgabe
+void CabinetLight::vlog(const char* prefix, const char* fmt, va_list args) {
+    // LOG/USB nur in der Hauptschleife messen: die Buckets sind nicht IRQ-sicher, und Logzeit
+    // im Interrupt ist bereits in Bucket::IRQ enthalten
+    bool timed = __get_current_exception() == 0;
+    char line[LOG_LINE_MAX];
+    uint32_t startUs = time_us_32();
+    size_t len = LogFormat::format(line, sizeof(line), "%s", prefix);
+    len += LogFormat::vformat(line + len, sizeof(line) - len, fmt, args);
+    uint32_t formattedUs = time_us_32();
+    {
+        TRACE_SCOPE(USB, "stdio");
+        stdio_put_string(line, len, false, true);
+    }
+    if (timed) {
+        LoadMeter::add(LoadMeter::Bucket::LOG, formattedUs - startUs);
+        LoadMeter::add(LoadMeter::Bucket::USB, time_us_32() - formattedUs);
+    }
+}
+
+// Ausgabe mit festem Präfix (ohne Filterprüfung)
+void CabinetLight::logPrefixed(const char* prefix, const char* fmt, ...) {
+    va_list args; va_start(args, fmt); vlog(prefix, fmt, args); va_end(args);
+}
+
 // Gibt eine Fehlermeldung aus (sofern LogLevel >= ERROR)
 void CabinetLight::logError(const char* fmt, ...) {
     if (logLevel >= LogLevel::ERROR) {
-        printf("[ERROR] ");
-        va_list args; va_start(args, fmt); vprintf(fmt, args); va_end(args);
+        va_list args; va_start(args, fmt); vlog("[ERROR] ", fmt, args); va_end(args);
     }
 }
 
 // Gibt eine Warnung aus (sofern LogLevel >= WARN)
 void CabinetLight::logWarn(const char* fmt, ...) {
     if (logLevel >= LogLevel::WARN) {
-        printf("[WARN] ");
-        va_list args; va_start(args, fmt); vprintf(fmt, args); va_end(args);
+        va_list args; va_start(args, fmt); vlog("[WARN] ", fmt, args); va_end(args);
     }
 }
 
 // Gibt eine Info-Meldung aus (sofern LogLevel >= INFO)
 void CabinetLight::logInfo(const char* fmt, ...) {
     if (logLevel >= LogLevel::INFO) {
-        printf("[INFO] ");
-        va_list args; va_start(args, fmt); vprintf(fmt, args); va_end(args);
+        va_list args; va_start(args, fmt); vlog("[INFO] ", fmt, args); va_end(args);
     }
 }
 
 // Gibt eine Debug-Meldung aus (sofern LogLevel >= DEBUG)
 void CabinetLight::logDebug(const char* fmt, ...) {
     if (logLevel >= LogLevel::DEBUG) {
-        printf("[DEBUG] ");
-        va_list args; va_start(args, fmt); vprintf(fmt, args); va_end(args);
+        va_list args; va_start(args, fmt); vlog("[DEBUG] ", fmt, args); va_end(args);
     }
 }
\ No newline at end of file
@@ -14,13 +14,26 @@
  * - Fehlerbehandlung mit LED-Signalisierung
  * - Heartbeat-LED als Lebenszeichen
  * - Startup-Test für alle LED-Kanäle
+ * - Keyframe-Animationen pro Kanal (Atmen, Puls, Lauflicht)
+ * - Ebenen-Compositor mit Prioritäten und Blend-Modi für überlagerte Lichtquellen
+ * - Frame-Rendering mit fester Bildrate während Fading/Animationen, ohne Timer im Leerlauf
+ * - Konfigurierbare Sensor-Kanal-Matrix (mehrere Türen auf ein Fach, eine Tür auf mehrere Fächer)
+ * - Auslöserarten je Sensor: Reedkontakt, Bewegungsmelder (PIR) mit Haltezeit, Taster
+ * - Dimmen per Taster (gedrückt halten) mit beschleunigter Rampe und gemerkter Helligkeit
+ * - Fading-Dauer je Kanal und Richtung (z.B. schnell an, langsam aus)
+ * - Nachleuchten nach dem Schließen, erneutes Öffnen bricht es ohne Einbruch ab
+ * - Bestätigende Entprellung mit optionalem spekulativem Vorglimmen ab der ersten Flanke
+ * - Startabgleich: beim Start offene Türen leuchten sofort (syncSensors())
+ * - Nutzungsstatistik je Kanal (Öffnungen, Öffnungsdauer-Histogramm, Prellen)
+ * - CPU-Lastmessung je Teilsystem und Histogramm der Schleifenperiode (LoadMeter)
+ * - Optionales Tracing (CABINET_TRACE) mit Export in das Chrome-Trace-Format
  *
  * \par Beispiel für die Nutzung
  * \code{.cpp}
  * #include "cabinetLight.h"
  * static CabinetLight light;
  * light.setSensorPolarity({true, true, true, true});
- * light.runStartupTest();
+ * if (!light.syncSensors()) light.runStartupTest();
  * while (true) {
  *     light.process();
  * }
@@ -43,6 +56,16 @@
 #include "hardware/gpio.h"  // Für GPIO-Hardwarezugriff
 #include "hardware/pwm.h"   // Für PWM-Hardwarezugriff
 #include <atomic>           // Für std::atomic
+#include "lightAnimation.h" // Für Keyframe-Animationen
+#include "lightCompositor.h" // Für Ebenen und Blend-Modi
+#include "frameRenderer.h"  // Für den Frame-Takt
+#include "cabinetConfig.h"  // Für die persistente Konfiguration
+#include "eventStats.h"     // Für die Nutzungsstatistik
+#include "loadMeter.h"      // Für die Lastmessung
+#include "trace.h"          // Für Trace-Spans
+#include "logFormat.h"      // Für die Formatierung der Logmeldungen
+#include "logRateLimiter.h" // Für die Ratenbegrenzung der LOG_*-Makros
+#include <cstdarg>          // Für va_list
 
 /**
  * @class CabinetLight
@@ -79,33 +102,12 @@ public:
         return instance.load(std::memory_order_acquire);
     }
 
-    /**
-     * @brief Lässt die Onboard-LED blinken (z.B. als Boot- oder Heartbeat-Anzeige).
-     * @param times Anzahl der Blinkzyklen
-     * @param on_ms Dauer LED an (ms)
-     * @param off_ms Dauer LED aus (ms)
-     */
-
-    /**
-     * @brief Lässt die Onboard-LED blinken (z.B. als Boot- oder Heartbeat-Anzeige).
-     *
-     * @param times  Anzahl der Blinkzyklen
-     * @param on_ms  Dauer LED an (ms)
-     * @param off_ms Dauer LED aus (ms)
-     *
-     * @details Diese Methode kann genutzt werden, um einen Boot- oder Fehlerstatus optisch anzuzeigen.
-     */
-    static void blinkOnboardLed(int times, int on_ms, int off_ms);
-
-    /**
-     * @brief Endlosschleife für Fehleranzeige (Onboard-LED schnelles Blinken).
-     * @noreturn
-     */
-
     /**
      * @brief Endlosschleife für Fehleranzeige (Onboard-LED schnelles Blinken).
      *
      * @details Wird bei fatalen Fehlern aufgerufen und signalisiert dauerhaft einen Fehlerzustand.
+     *          Der Fehler wird vorher für den Absturzbericht beim nächsten Start vermerkt (CrashReport).
+     *          Das Blinken übernimmt StatusLed (FATAL-Muster per Timer); die CPU schläft in WFI.
      * @noreturn
      */
     [[noreturn]] static void fatalErrorBlink();
@@ -149,16 +151,30 @@ public:
     /**
      * @brief Entprellzeit für Sensoren in Millisekunden (Standard: 100 ms).
      *
-     * @details Verhindert Mehrfachauslösung durch Prellen der Reedkontakte.
+     * @details Ein Sensorpegel wird erst übernommen, wenn er DEBOUNCE_MS nach der letzten Flanke stabil ist.
      */
     static constexpr uint16_t DEBOUNCE_MS = 100;
 
+    /**
+     * @brief Startabgleich: Anzahl und Abstand der Abtastungen (µs), die ein Pegel übereinstimmen muss.
+     *
+     * @details Ein ruhender Sensor wird beim Start nach BOOT_SYNC_SAMPLES gleichen Abtastungen sofort
+     *          übernommen; ein wechselnder Pegel durchläuft die normale Entprellung (DEBOUNCE_MS).
+     */
+    static constexpr uint32_t BOOT_SYNC_SAMPLES = 5;
+    static constexpr uint32_t BOOT_SYNC_INTERVAL_US = 1000;
+
+    /**
+     * @brief Pegel des spekulativen Vorglimmens während der Entprellung (PWM-Level).
+     */
+    static constexpr uint16_t SPECULATIVE_LEVEL = PWM_WRAP / 10;
+
     /**
      * @brief Schrittweite für das Dimmen pro process()-Aufruf.
      */
 
     /**
-     * @brief Schrittweite für das Dimmen pro process()-Aufruf (PWM-Level pro Schritt).
+     * @brief Schrittweite für das Dimmen pro FADING_STEP_MS (PWM-Level pro Schritt).
      */
     static constexpr uint16_t FADE_STEP = 1000;
 
@@ -167,9 +183,10 @@ public:
      */
 
     /**
-     * @brief Standard-Intervall für das Heartbeat-Blinken (Millisekunden).
+     * @brief Mindestabstand der periodischen Prüfungen in der Hauptschleife (Millisekunden).
      *
-     * @details Gibt an, wie oft die Heartbeat-LED im Normalbetrieb blinkt.
+     * @details Die Prüfungen laufen nur bei ohnehin erfolgtem Aufwachen und erzeugen keine eigene
+     *          Weckzeit. Den Heartbeat der Onboard-LED übernimmt StatusLed (PWM/DMA).
      */
     static constexpr uint32_t HEARTBEAT_INTERVAL_MS = 1000;
 
@@ -179,9 +196,32 @@ public:
 
     /**
      * @brief Standard-Intervall für Fading-Schritte (Millisekunden).
+     *
+     * @details Bezugsintervall für FADE_STEP; die Fading-Geschwindigkeit beträgt FADE_STEP / FADING_STEP_MS.
      */
     static constexpr uint32_t FADING_STEP_MS = 50;
 
+    /**
+     * @brief Bildrate des Frame-Renderers während Fading und Animationen (Hz).
+     */
+    static constexpr uint32_t FRAME_RATE_HZ = 200;
+
+    /**
+     * @brief Fading-Schrittweite pro Frame (PWM-Level), abgeleitet aus FADE_STEP und FADING_STEP_MS.
+     */
+    static constexpr uint32_t FADE_STEP_PER_FRAME = (FADE_STEP * 1000u) / (FADING_STEP_MS * FRAME_RATE_HZ);
+    static_assert(FADE_STEP_PER_FRAME > 0, "FRAME_RATE_HZ zu hoch für FADE_STEP/FADING_STEP_MS");
+
+    /**
+     * @brief Kürzeste einstellbare Fading-Dauer (Millisekunden): ein Frame.
+     */
+    static constexpr uint32_t MIN_FADE_MS = 1000u / FRAME_RATE_HZ;
+
+    /**
+     * @brief Aufrufintervall für das Polling-Fallback (Millisekunden).
+     */
+    static constexpr uint32_t POLL_INTERVAL_MS = 50;
+
     /**
      * @brief Verzögerung für LED-Test beim Start (Millisekunden)
      */
@@ -203,6 +243,43 @@ public:
      */
     static constexpr uint32_t PWM_TEST_DELAY_MS = 100;
 
+    /**
+     * @brief Intervall der Kanalprüfung und der Wiederholungsversuche für defekte Kanäle (ms).
+     */
+    static constexpr uint32_t HEALTH_CHECK_INTERVAL_MS = 5000;
+
+    /**
+     * @brief Dauer, nach der eine offene Tür in das langsame Atmen wechselt (Millisekunden).
+     *
+     * @details 0 deaktiviert das Atmen. Kann über setLongOpenBreathing() geändert werden.
+     */
+    static constexpr uint32_t LONG_OPEN_BREATHE_MS = 5 * 60 * 1000;
+
+    /**
+     * @brief Mindestdauer eines Tasterdrucks, ab der gedimmt statt umgeschaltet wird (Millisekunden).
+     */
+    static constexpr uint32_t LONG_PRESS_MS = 500;
+
+    /**
+     * @brief Anfangsgeschwindigkeit der Dimmrampe (PWM-Level pro Sekunde).
+     */
+    static constexpr uint32_t RAMP_BASE_RATE = PWM_WRAP / 5;
+
+    /**
+     * @brief Beschleunigung der Dimmrampe (PWM-Level pro Sekunde²).
+     */
+    static constexpr uint32_t RAMP_ACCEL = PWM_WRAP / 2;
+
+    /**
+     * @brief Maximale Geschwindigkeit der Dimmrampe (PWM-Level pro Sekunde).
+     */
+    static constexpr uint32_t RAMP_MAX_RATE = PWM_WRAP;
+
+    /**
+     * @brief Untere Grenze der Dimmrampe (PWM-Level); ein gedimmter Kanal bleibt sichtbar an.
+     */
+    static constexpr uint16_t RAMP_MIN_LEVEL = PWM_WRAP / 50;
+
     /**
      * @brief Default-GPIO-Pins für die LEDs (Definition in .cpp).
      */
@@ -262,16 +339,99 @@ public:
      */
     std::array<uint16_t, DEV_COUNT> targetLevel = {};
 
+    /**
+     * @brief Helligkeit, auf die ein Kanal beim Einschalten fadet (per Taster gedimmt, Standard PWM_WRAP).
+     */
+    std::array<uint16_t, DEV_COUNT> dimLevel = {};
+
+    /**
+     * @brief Ausgegebene PWM-Level (0..PWM_WRAP) je Kanal nach Verrechnung aller Ebenen.
+     */
+    std::array<uint16_t, DEV_COUNT> outputLevel = {};
+
     /**
      * @brief Gibt an, ob ein Kanal gerade fadet (Dimmen aktiv).
      */
     std::array<bool, DEV_COUNT> fading = {};
 
+    /**
+     * @brief Zeitpunkt, zu dem der Kanal zuletzt eingeschaltet wurde (Tür geöffnet).
+     */
+    std::array<absolute_time_t, DEV_COUNT> openSince = {};
+
+    /**
+     * @brief Von der Animations-Engine berechnete Pegel (0..PWM_WRAP) je Kanal.
+     *
+     * @details Nur gültig für Kanäle in animationMask.
+     */
+    std::array<uint16_t, DEV_COUNT> animationLevel = {};
+
+    /**
+     * @brief Bitmaske der Kanäle, deren PWM-Ausgang aktuell von einer Animation bestimmt wird.
+     */
+    uint8_t animationMask = 0;
+
     /**
      * @brief Letzter gelesener GPIO-Zustand (für Polling-Fallback).
      */
     std::array<bool, DEV_COUNT> lastRawState = {};
     
+    /**
+     * @brief Entprellter Sensorzustand: Bit s gesetzt = Sensor s meldet "Tür offen".
+     */
+    uint8_t sensorActiveMask = 0;
+
+    /**
+     * @brief Entprellter Sensorpegel nach Polarity: Bit s gesetzt = Sensor s aktiv.
+     *
+     * @details Für Reedkontakte identisch mit sensorActiveMask, für PIR und Taster der Eingangspegel.
+     */
+    uint8_t sensorLevelMask = 0;
+
+    /**
+     * @brief Statistik des spekulativen Vorglimmens.
+     */
+    struct SpeculationStats {
+        uint32_t starts;        ///< Gestartete Vorglimm-Vorgänge (erste Flanke)
+        uint32_t commits;       ///< Von der Entprellung bestätigt
+        uint32_t rollbacks;     ///< Verworfen (Prellen/Störimpuls)
+        uint64_t gainUsTotal;   ///< Summe der gewonnenen Latenz (erste Flanke bis Bestätigung, µs)
+    };
+
+    /**
+     * @brief Messwerte des Startabgleichs (Zeiten in µs seit Reset, 0 = nicht erreicht).
+     */
+    struct BootSyncStats {
+        uint32_t sampleUs;      ///< Erste Abtastung aller Sensoren (gpio_get_all())
+        uint32_t settledUs;     ///< Pegel bestätigt, Fading gestartet
+        uint32_t firstLightUs;  ///< Erster Kanal des Startabgleichs mit sichtbarem Ausgangspegel
+        uint8_t activeMask;     ///< Beim Start aktive Sensoren (nach Polarity)
+        uint8_t unsettledMask;  ///< Sensoren mit wechselndem Pegel (an die Entprellung übergeben)
+        uint8_t channelMask;    ///< Vom Startabgleich eingeschaltete Kanäle
+    };
+
+    /**
+     * @brief Flankenzähler eines Sensors auf dem IRQ-Pfad.
+     */
+    struct EdgeStats {
+        uint32_t irqEdges;      ///< Vom IRQ-Handler gemeldete Flanken
+        uint32_t consumedEdges; ///< Von process() abgeholte Ereignisse (pendingMask-Bits)
+        uint32_t coalesced;     ///< Zusammengefasste Flanken: irqEdges - consumedEdges - noch anstehende
+    };
+
+    /**
+     * @brief Vom IRQ-Handler gezählte Flanken je Sensor.
+     *
+     * @threadsafe
+     * @details Wird im IRQ-Kontext erhöht, bevor das Bit in pendingMask gesetzt wird.
+     */
+    std::array<std::atomic<uint32_t>, DEV_COUNT> irqEdgeCount = {};
+
+    /**
+     * @brief Von process() abgeholte Ereignisse je Sensor (nur Hauptschleife).
+     */
+    std::array<uint32_t, DEV_COUNT> consumedEdgeCount = {};
+
     /**
      * @brief Bitmaske für anstehende Sensorereignisse (IRQ-sicher, atomar).
      *
@@ -302,6 +462,30 @@ public:
         DEBUG = 3 
     };
 
+    /**
+     * @brief Anzahl der LogLevel.
+     */
+    static constexpr size_t LOG_LEVEL_COUNT = 4;
+
+    /**
+     * @brief Teilsystem einer Logmeldung (Filter über setLogTagMask(), Präfix z.B. "[DEBUG][SENSOR] ").
+     */
+    enum class LogTag : uint8_t {
+        IRQ    = 0,     ///< GPIO-Interrupts
+        SENSOR = 1,     ///< Sensorauswertung, Auslöser, Tasten
+        FADE   = 2,     ///< Fading, Rampen, Animationen, Nachleuchten
+        PWM    = 3,     ///< PWM-Ausgänge
+        INIT   = 4,     ///< Initialisierung und Konfiguration
+        SYS    = 5,     ///< Systemüberwachung (Watchdog, Schleifenlatenz)
+        COUNT  = 6      ///< Anzahl der Teilsysteme
+    };
+
+    /**
+     * @brief Anzahl der Teilsysteme und Maske mit allen Teilsystemen.
+     */
+    static constexpr size_t LOG_TAG_COUNT = static_cast<size_t>(LogTag::COUNT);
+    static constexpr uint8_t LOG_TAG_ALL = (1u << LOG_TAG_COUNT) - 1;
+
     /**
      * @brief Konstruktor: Initialisiert GPIOs und PWM für alle Kanäle.
      *
@@ -312,21 +496,42 @@ public:
     /**
      * @brief Gibt den Initialisierungsstatus zurück.
      *
-     * @return true = erfolgreich, false = Fehler aufgetreten
+     * @return true = betriebsbereit (mindestens ein LED-Kanal funktioniert), false = kein Kanal nutzbar
      *
-     * @details Sollte nach dem Konstruktor geprüft werden, um Hardwarefehler zu erkennen.
+     * @details Sollte nach dem Konstruktor geprüft werden. Einzelne defekte Kanäle führen nur zu
+     *          eingeschränktem Betrieb (siehe getFaultMask()).
      */
     bool isInitialized() const { return initialized; }
 
+    /**
+     * @brief Kanäle, deren LED-Ausgang nicht initialisiert werden konnte oder ausgefallen ist (Bitmaske).
+     */
+    uint8_t getLedFaultMask() const { return static_cast<uint8_t>(~ledHealthyMask & ((1u << DEV_COUNT) - 1u)); }
+
+    /**
+     * @brief Sensoren, die nicht initialisiert werden konnten oder ausgefallen sind (Bitmaske).
+     */
+    uint8_t getSensorFaultMask() const { return static_cast<uint8_t>(~sensorHealthyMask & ((1u << DEV_COUNT) - 1u)); }
+
+    /**
+     * @brief Kanäle bzw. Sensoren mit Fehler (0 = voller Betrieb, sonst eingeschränkter Betrieb).
+     *
+     * @details Defekte LED-Kanäle werden nicht angesteuert, defekte Sensoren gelten als inaktiv.
+     *          Beide werden alle HEALTH_CHECK_INTERVAL_MS erneut initialisiert; die Onboard-LED zeigt
+     *          den niedrigsten Fehler als Blinkcode (LED-Kanal c: c+1 Impulse, Sensor s: s+5 Impulse).
+     */
+    uint8_t getFaultMask() const { return getLedFaultMask() | getSensorFaultMask(); }
+
     /**
      * @brief Initialisiert die PWM für einen LED-Kanal. Prüft Pin-Gültigkeit.
      *
-     * @param gpio GPIO-Pin für die LED
+     * @param gpio      GPIO-Pin für die LED
+     * @param testBlink Kurzes Aufblitzen als Funktionstest (blockiert PWM_TEST_DELAY_MS)
      * @return true bei Erfolg, false bei Fehler
      *
-     * @details Diese Methode wird intern beim Setzen der Pins verwendet.
+     * @details Diese Methode wird intern beim Setzen der Pins und bei Wiederholungsversuchen verwendet.
      */
-    bool setupPwmLEDs(uint8_t gpio);
+    bool setupPwmLEDs(uint8_t gpio, bool testBlink = true);
 
     /**
      * @brief Initialisiert die Sensor-GPIOs und IRQs für einen Kanal. Prüft Pin-Gültigkeit.
@@ -352,9 +557,67 @@ public:
      * @brief Verarbeitet anstehende Events (z. B. Sensoränderungen, Fading).
      *
      * @warning Nicht thread-safe! Darf nur aus einem Thread (z.B. der Mainloop) aufgerufen werden.
-     * @details Diese Methode sollte regelmäßig in der Hauptschleife aufgerufen werden, um Sensor- und LED-Events zu verarbeiten.
+     * @details Diese Methode sollte nach jedem Aufwachen der Hauptschleife aufgerufen werden. Fading und Animationen werden nur zu Frame-Ticks des FrameRenderer berechnet, Sensorereignisse sofort.
      */
     void process();
+
+    /**
+     * @brief Nächster Zeitpunkt, zu dem process() ohne IRQ oder Frame-Tick aufgerufen werden muss.
+     *
+     * @return Absolute Deadline (at_the_end_of_time, wenn nur Ereignisse abzuwarten sind)
+     *
+     * @details Die Hauptschleife kann bis zu diesem Zeitpunkt per WFE schlafen. GPIO-IRQs und der Frame-Timer wecken sie vorher.
+     */
+    absolute_time_t nextDeadline() const;
+
+    /**
+     * @brief Gibt die Statistik des Frame-Renderers zurück (verpasste Frames, Überläufe, Renderzeit).
+     */
+    FrameRenderer::Stats getFrameStats() const { return renderer.getStats(); }
+
+    /**
+     * @brief Aktiviert/deaktiviert das spekulative Vorglimmen (Standard: aktiv).
+     *
+     * @param enable true = Kanal glimmt ab der ersten Flanke mit SPECULATIVE_LEVEL
+     *
+     * @details Bestätigt die Entprellung die Flanke, setzt das Fading am Vorglimm-Pegel fort.
+     * War es ein Prellen, wird das Vorglimmen ohne Fading zurückgenommen. Nur für Reedkontakte.
+     */
+    void setSpeculativeLight(bool enable);
+
+    /**
+     * @brief Gibt die Statistik des Vorglimmens zurück (Latenzgewinn gegenüber Fehlstarts).
+     */
+    SpeculationStats getSpeculationStats() const { return specStats; }
+
+    /**
+     * @brief Gibt die Messwerte des Startabgleichs zurück (siehe syncSensors()).
+     */
+    BootSyncStats getBootSyncStats() const { return bootStats; }
+
+    /**
+     * @brief Gibt die Flankenzähler eines Sensors zurück.
+     *
+     * @param sensor Sensorindex (0..DEV_COUNT-1)
+     * @return Flankenzähler; coalesced zählt Flanken, die zusammengefasst wurden, bevor process() sie abholen konnte
+     *
+     * @details Ein steigender coalesced-Wert zeigt, dass die Hauptschleife für diesen Sensor zu selten läuft.
+     */
+    EdgeStats getEdgeStats(size_t sensor) const;
+
+    /**
+     * @brief Liefert eine konsistente Kopie der Nutzungsstatistik (Öffnungen, Dauer-Histogramm, Prellen).
+     *
+     * @threadsafe
+     * @param out Ausgabe
+     * @return true bei Erfolg, false wenn die Statistik während aller Leseversuche geschrieben wurde
+     */
+    bool getEventStats(EventStats::Snapshot& out) const { return eventStats.snapshot(out); }
+
+    /**
+     * @brief Setzt die Nutzungsstatistik zurück.
+     */
+    void resetEventStats() { eventStats.reset(); }
     
     /**
      * @brief Setzt die GPIO-Pins für die LED-Kanäle und reinitialisiert PWM. Prüft Pins.
@@ -396,6 +659,144 @@ public:
      */
     void runStartupTest();
 
+    /**
+     * @brief Startabgleich: übernimmt den aktuellen Zustand aller Sensoren und startet das Fading sofort.
+     *
+     * @warning Nicht thread-safe! Darf nicht parallel zu anderen Methoden aufgerufen werden.
+     * @return true, wenn dabei mindestens ein Kanal eingeschaltet wurde (z.B. Tür beim Start offen)
+     *
+     * @details Liest alle Sensoren BOOT_SYNC_SAMPLES-mal mit je einem gpio_get_all() und wendet die Polarity an
+     *          (daher nach setSensorPolarity() aufrufen). Ruhende Pegel gelten sofort, wechselnde durchlaufen die
+     *          normale Entprellung. Taster, die beim Start gedrückt sind, schalten nicht um. Ohne Startabgleich
+     *          bliebe eine beim Start offene Tür dunkel, bis sie geschlossen und wieder geöffnet wird.
+     *          Die Zeitpunkte bis zum ersten sichtbaren Licht stehen in getBootSyncStats().
+     */
+    bool syncSensors();
+
+    // === Sensor-Kanal-Matrix und Konfiguration ===
+
+    /**
+     * @brief Ordnet einem Sensor die Kanäle zu, die er schaltet.
+     *
+     * @warning Nicht thread-safe! Darf nur aus der Hauptschleife aufgerufen werden.
+     * @param sensor      Sensorindex (0..DEV_COUNT-1)
+     * @param channelMask Bitmaske der Kanäle (Bit c = Kanal c)
+     *
+     * @details Standard ist Sensor i -> Kanal i. Die Änderung wirkt sofort, gespeichert wird erst mit saveConfig().
+     */
+    void setSensorChannelMap(size_t sensor, uint8_t channelMask);
+
+    /**
+     * @brief Setzt die Verknüpfungsregel für Kanäle mit mehreren Sensoren.
+     *
+     * @param channel Kanalindex (0..DEV_COUNT-1)
+     * @param rule    MapRule::OR (ein Sensor genügt) oder MapRule::AND (alle Sensoren)
+     */
+    void setChannelRule(size_t channel, MapRule rule);
+
+    /**
+     * @brief Setzt die Auslöserart eines Sensors.
+     *
+     * @warning Nicht thread-safe! Darf nur aus der Hauptschleife aufgerufen werden.
+     * @param sensor Sensorindex (0..DEV_COUNT-1)
+     * @param type   TriggerType::REED (Pegel = Türzustand), PIR (Haltezeit, bei jedem Puls neu gestartet) oder BUTTON (Umschalten bei jedem Druck)
+     * @param holdS  Haltezeit in Sekunden (nur PIR)
+     */
+    void setTriggerType(size_t sensor, TriggerType type, uint16_t holdS = 60);
+
+    /**
+     * @brief Setzt die Fading-Dauer eines Kanals getrennt für Ein- und Ausblenden.
+     *
+     * @param channel   Kanalindex (0..DEV_COUNT-1)
+     * @param fadeInMs  Dauer von 0 auf volle Helligkeit in ms (0 = Standard, FADE_STEP/FADING_STEP_MS)
+     * @param fadeOutMs Dauer von voller Helligkeit auf 0 in ms (0 = Standard)
+     *
+     * @details Die Schrittweiten pro Frame werden hier einmalig berechnet, das Fading selbst kommt ohne Division aus.
+     */
+    void setChannelFade(size_t channel, uint16_t fadeInMs, uint16_t fadeOutMs);
+
+    /**
+     * @brief Setzt die Nachleuchtdauer eines Kanals.
+     *
+     * @param channel Kanalindex (0..DEV_COUNT-1)
+     * @param seconds Dauer in Sekunden, die das Licht nach dem Schließen an bleibt, bevor es ausblendet (0 = aus)
+     *
+     * @details Wird die Tür während des Nachleuchtens wieder geöffnet, bleibt das Licht ohne Einbruch an.
+     */
+    void setChannelAfterglow(size_t channel, uint16_t seconds);
+
+    /**
+     * @brief Lädt die Konfiguration aus dem Flash und wendet sie an.
+     * @return true, wenn gültige Daten gefunden wurden (sonst Standardwerte)
+     */
+    bool loadConfig();
+
+    /**
+     * @brief Speichert die aktuelle Konfiguration im Flash.
+     *
+     * @warning Sperrt für die Dauer des Flash-Zugriffs alle Interrupts (ca. 50 ms).
+     * @return true bei Erfolg
+     */
+    bool saveConfig();
+
+    /**
+     * @brief Gibt die aktuelle Konfiguration zurück.
+     */
+    const CabinetConfig& getConfig() const { return config; }
+
+    // === Animationen ===
+
+    /**
+     * @brief Startet ein Keyframe-Programm auf einem Kanal.
+     *
+     * @warning Nicht thread-safe! Darf nur aus der Hauptschleife aufgerufen werden.
+     * @param channel Kanalindex (0..DEV_COUNT-1)
+     * @param program Programm im Flash (z.B. LightAnimation::BREATHE)
+     * @param delayMs Startverzögerung in Millisekunden
+     * @param layer   Ebene, in die die Animation schreibt (z.B. WARNING für einen Puls)
+     * @return true bei Erfolg, false bei ungültigem Kanal oder Programm
+     *
+     * @details Die Animation startet beim aktuell sichtbaren Pegel des Kanals (bei MULTIPLY-Ebenen neutral bei PWM_WRAP) und wird mit dem Blend-Modus der Ebene verrechnet, bis sie endet oder gestoppt wird.
+     */
+    bool startAnimation(size_t channel, const LightAnimation::Program& program, uint32_t delayMs = 0,
+                        LightCompositor::Layer layer = LightCompositor::Layer::ANIMATION);
+
+    /**
+     * @brief Stoppt die Animation eines Kanals, der Kanal kehrt zum Tür-Pegel zurück.
+     *
+     * @param channel Kanalindex (0..DEV_COUNT-1)
+     */
+    void stopAnimation(size_t channel);
+
+    /**
+     * @brief Setzt eine manuelle Übersteuerung für einen Kanal (höchste Priorität).
+     *
+     * @param channel Kanalindex (0..DEV_COUNT-1)
+     * @param level   PWM-Level (0..PWM_WRAP)
+     */
+    void setManualLevel(size_t channel, uint16_t level);
+
+    /**
+     * @brief Hebt die manuelle Übersteuerung eines Kanals auf.
+     * @param channel Kanalindex (0..DEV_COUNT-1)
+     */
+    void clearManualLevel(size_t channel);
+
+    /**
+     * @brief Startet ein Programm als Lauflicht über alle Kanäle.
+     *
+     * @param program Programm im Flash (z.B. LightAnimation::CHASE)
+     * @param stepMs  Versatz zwischen zwei benachbarten Kanälen in Millisekunden
+     */
+    void startChase(const LightAnimation::Program& program, uint32_t stepMs);
+
+    /**
+     * @brief Setzt die Dauer, nach der eine offene Tür langsam zu atmen beginnt.
+     *
+     * @param ms Dauer in Millisekunden (0 = deaktiviert)
+     */
+    void setLongOpenBreathing(uint32_t ms);
+
     // === Logging ===
 
     /**
@@ -410,30 +811,61 @@ public:
      */
     static LogLevel getLogLevel();
 
+    /**
+     * @brief Setzt die Teilsysteme, deren Meldungen über die LOG_*-Makros ausgegeben werden.
+     * @param mask Bitmaske (Bit n = LogTag n), Standard LOG_TAG_ALL
+     */
+    static void setLogTagMask(uint8_t mask);
+
+    /**
+     * @brief Gibt die aktuelle Teilsystem-Maske zurück.
+     */
+    static uint8_t getLogTagMask();
+
+    /**
+     * @brief Filterprüfung der LOG_*-Makros: LogLevel und Teilsystem in einem Tabellenzugriff.
+     *
+     * @details Bei konstanten Argumenten ein Ladebefehl und ein Bittest.
+     */
+    static bool logEnabled(LogLevel level, LogTag tag) {
+        return (logFilter[static_cast<size_t>(level)] >> static_cast<uint8_t>(tag)) & 1u;
+    }
+
+    /**
+     * @brief Ausgabe einer Meldung mit Teilsystem-Präfix (ohne Filterprüfung, Aufruf über die LOG_*-Makros).
+     *
+     * @param level      LogLevel
+     * @param tag        Teilsystem
+     * @param suppressed Anzahl der zuvor an dieser Stelle unterdrückten Meldungen (0 = keine Zusammenfassung)
+     * @param fmt        Formatstring (siehe LogFormat)
+     * @param ...        Argumente
+     */
+    static void logTagged(LogLevel level, LogTag tag, uint32_t suppressed, const char* fmt, ...);
+
     /**
      * @brief Gibt eine Fehlermeldung aus (LogLevel ERROR).
-     * @param fmt Formatstring (wie printf)
+     * @param fmt Formatstring (%d, %u, %x, %s, %c mit Feldbreite, siehe LogFormat)
      * @param ... Argumente
      */
     static void logError(const char* fmt, ...);
 
     /**
      * @brief Gibt eine Warnung aus (LogLevel WARN).
-     * @param fmt Formatstring (wie printf)
+     * @param fmt Formatstring (%d, %u, %x, %s, %c mit Feldbreite, siehe LogFormat)
      * @param ... Argumente
      */
     static void logWarn(const char* fmt, ...);
 
     /**
      * @brief Gibt eine Info-Meldung aus (LogLevel INFO).
-     * @param fmt Formatstring (wie printf)
+     * @param fmt Formatstring (%d, %u, %x, %s, %c mit Feldbreite, siehe LogFormat)
      * @param ... Argumente
      */
     static void logInfo(const char* fmt, ...);
 
     /**
      * @brief Gibt eine Debug-Meldung aus (LogLevel DEBUG).
-     * @param fmt Formatstring (wie printf)
+     * @param fmt Formatstring (%d, %u, %x, %s, %c mit Feldbreite, siehe LogFormat)
      * @param ... Argumente
      */
     static void logDebug(const char* fmt, ...);
@@ -461,12 +893,235 @@ private:
      */
     bool pollingFallback = false;
 
+    /**
+     * @brief Aktuelle (persistente) Konfiguration.
+     */
+    CabinetConfig config = ConfigStore::defaults();
+
+    /**
+     * @brief Bitmaske der Sensoren, die kein Reedkontakt sind (Tabellen-Dispatch in applyTrigger()).
+     */
+    uint8_t nonReedMask = 0;
+
+    /**
+     * @brief Bitmaske der Bewegungsmelder mit laufender Haltezeit.
+     */
+    uint8_t pirActiveMask = 0;
+
+    /**
+     * @brief Ende der Haltezeit je Bewegungsmelder.
+     */
+    std::array<absolute_time_t, DEV_COUNT> pirHoldUntil = {};
+
+    /**
+     * @brief Bitmaske der Kanäle im Nachleuchten (geschlossen, Licht noch an).
+     */
+    uint8_t afterglowMask = 0;
+
+    /**
+     * @brief Ende des Nachleuchtens je Kanal.
+     */
+    std::array<absolute_time_t, DEV_COUNT> afterglowUntil = {};
+
+    /**
+     * @brief Frühestes Ende aller Nachleucht-Zeiten (einziger Beitrag zu nextDeadline()).
+     */
+    absolute_time_t afterglowNext = at_the_end_of_time;
+
+    /**
+     * @brief Kanäle mit funktionierendem LED-Ausgang bzw. Sensor (Bitmaske).
+     */
+    uint8_t ledHealthyMask = 0;
+    uint8_t sensorHealthyMask = 0;
+
+    /**
+     * @brief Zeitpunkt der nächsten Kanalprüfung.
+     */
+    absolute_time_t healthCheckNext = at_the_end_of_time;
+
+    /**
+     * @brief Bitmaske der Sensoren, deren Entprellfenster läuft (Flanke noch nicht bestätigt).
+     */
+    uint8_t settleMask = 0;
+
+    /**
+     * @brief Gibt an, ob das spekulative Vorglimmen aktiv ist.
+     */
+    bool speculativeLight = true;
+
+    /**
+     * @brief Bitmaske der Sensoren mit laufendem Vorglimmen.
+     */
+    uint8_t specMask = 0;
+
+    /**
+     * @brief Von der Entprellung bestätigte Sensoren, deren Vorglimmen nach der Matrix aufgelöst wird.
+     */
+    uint8_t specConfirmMask = 0;
+
+    /**
+     * @brief Kanäle, die der Sensor vorglimmen lässt, und Startzeitpunkt (time_us_32()).
+     */
+    std::array<uint8_t, DEV_COUNT> specChannels = {};
+    std::array<uint32_t, DEV_COUNT> specStartUs = {};
+
+    /**
+     * @brief Statistik des Vorglimmens.
+     */
+    SpeculationStats specStats = {};
+
+    /**
+     * @brief Messwerte des Startabgleichs; Kanäle, deren erstes Licht noch gemessen wird.
+     */
+    BootSyncStats bootStats = {};
+    uint8_t bootLightMask = 0;
+
+    /**
+     * @brief Flanken je Sensor im laufenden Entprellfenster (für den Prellzähler).
+     */
+    std::array<uint8_t, DEV_COUNT> edgesInWindow = {};
+
+    /**
+     * @brief Nutzungsstatistik je Kanal.
+     */
+    EventStats eventStats;
+
+    /**
+     * @brief Bitmaske der Taster, die gerade gedrückt sind.
+     */
+    uint8_t buttonHeldMask = 0;
+
+    /**
+     * @brief Bitmaske der Taster, deren Dimmrampe läuft (langer Druck).
+     */
+    uint8_t rampMask = 0;
+
+    /**
+     * @brief Richtung der Dimmrampe je Taster: Bit gesetzt = heller.
+     */
+    uint8_t rampUpMask = 0;
+
+    /**
+     * @brief Zeitpunkt des Drucks je Taster.
+     */
+    std::array<absolute_time_t, DEV_COUNT> buttonPressedAt = {};
+
+    /**
+     * @brief Start und letzter Schritt der Dimmrampe je Taster (time_us_32()).
+     */
+    std::array<uint32_t, DEV_COUNT> rampStartUs = {};
+    std::array<uint32_t, DEV_COUNT> rampLastUs = {};
+
+    /**
+     * @brief Nicht ausgegebener Rest der Dimmrampe je Taster (PWM-Level · µs).
+     */
+    std::array<uint32_t, DEV_COUNT> rampRemainder = {};
+
+    /**
+     * @brief Anzahl der Auslöserarten (Größe von TRIGGER_HANDLERS).
+     */
+    static constexpr size_t TRIGGER_TYPE_COUNT = 3;
+
+    /**
+     * @brief Behandlungsroutine einer Auslöserart: setzt/löscht das Bit des Sensors in sensors.
+     */
+    using TriggerHandler = void (CabinetLight::*)(size_t sensor, bool active, uint8_t& sensors);
+
+    /**
+     * @brief Dispatch-Tabelle, indiziert mit TriggerType.
+     */
+    static const TriggerHandler TRIGGER_HANDLERS[TRIGGER_TYPE_COUNT];
+
+    /**
+     * @brief Transponierte Sensor-Kanal-Matrix: Bit s in channelSensorMask[c] = Sensor s wirkt auf Kanal c.
+     *
+     * @details Wird in applyConfig() aus config.sensorChannelMap abgeleitet.
+     */
+    std::array<uint8_t, DEV_COUNT> channelSensorMask = {};
+
+    /**
+     * @brief Dauer bis zum Atmen bei offener Tür (0 = deaktiviert).
+     */
+    uint32_t longOpenBreathMs = LONG_OPEN_BREATHE_MS;
+
+    /**
+     * @brief Animations-Engine für alle Kanäle.
+     */
+    LightAnimation animation{PWM_WRAP};
+
+    /**
+     * @brief Ebene, in die die Animation eines Kanals schreibt.
+     */
+    std::array<LightCompositor::Layer, DEV_COUNT> animationLayer = {};
+
+    /**
+     * @brief Ebenen-Compositor: verrechnet Tür, Animationen, Test und Übersteuerung.
+     */
+    LightCompositor compositor{PWM_WRAP};
+
+    /**
+     * @brief Frame-Taktgeber (FRAME_RATE_HZ während Fading/Animationen, gestoppt im Leerlauf).
+     */
+    FrameRenderer renderer{FRAME_RATE_HZ};
+
+    /**
+     * @brief Vorberechnete Fading-Schrittweite pro Frame je Kanal (Q16, PWM-Level · 2^16).
+     */
+    std::array<uint32_t, DEV_COUNT> fadeInStepQ16 = {};
+    std::array<uint32_t, DEV_COUNT> fadeOutStepQ16 = {};
+
+    /**
+     * @brief Nachkommaanteil des Fadings je Kanal (Q16).
+     */
+    std::array<uint16_t, DEV_COUNT> fadeFracQ16 = {};
+
+    /**
+     * @brief Bitmaske der Kanäle, deren currentLevel oder animationLevel sich seit der letzten Ausgabe geändert hat.
+     *
+     * @details Wird an jeder Schreibstelle der Pegel-Arrays gesetzt (setCurrentLevel(), processAnimations()).
+     */
+    uint8_t levelDirtyMask = 0;
+
 
     /**
      * @brief Globales LogLevel für die Logging-API.
      */
     static LogLevel logLevel;
 
+    /**
+     * @brief Teilsystem-Maske für die LOG_*-Makros.
+     */
+    static uint8_t logTagMask;
+
+    /**
+     * @brief Freigegebene Teilsysteme je LogLevel (logTagMask oder 0), aktualisiert von setLogLevel()/setLogTagMask().
+     */
+    static uint8_t logFilter[LOG_LEVEL_COUNT];
+
+    /**
+     * @brief Berechnet logFilter neu.
+     */
+    static void updateLogFilter();
+
+    /**
+     * @brief Maximale Länge einer formatierten Logmeldung inkl. Präfix (längere werden gekürzt).
+     */
+    static constexpr size_t LOG_LINE_MAX = 160;
+
+    /**
+     * @brief Gemeinsame Ausgabe aller Log-Funktionen: formatiert (LOG) und gibt über stdio aus (USB).
+     *
+     * @param prefix Präfix der Meldung (z.B. "[ERROR] ")
+     * @param fmt    Formatstring (Teilmenge von printf, siehe LogFormat)
+     * @param args   Argumente
+     */
+    static void vlog(const char* prefix, const char* fmt, va_list args);
+
+    /**
+     * @brief Wie vlog(), mit variabler Argumentliste.
+     */
+    static void logPrefixed(const char* prefix, const char* fmt, ...);
+
     /**
      * @brief Interner Initialisierungsstatus (true = OK, false = Fehler).
      */
@@ -482,6 +1137,178 @@ private:
      */
     void fadeLed(uint gpio, bool on);
 
+    /**
+     * @brief Schaltet einen Kanal nach einem erkannten Türereignis ein oder aus.
+     *
+     * @param idx Kanalindex
+     * @param on  true = Tür geöffnet, false = Tür geschlossen
+     *
+     * @details Gemeinsamer Pfad für alle Sensorquellen (Fading, Status, Animationen).
+     */
+    void setChannelState(size_t idx, bool on);
+
+    /**
+     * @brief Übersetzt einen entprellten Sensorpegel gemäß Auslöserart in den Sensorzustand.
+     *
+     * @param sensor  Sensorindex
+     * @param active  Entprellter Pegel nach Polarity (true = aktiv)
+     * @param sensors Sensorzustand des aktuellen Ereignis-Batches
+     *
+     * @details Reedkontakte werden ohne Tabellenzugriff behandelt, nur andere Arten laufen über TRIGGER_HANDLERS.
+     */
+    void applyTrigger(size_t sensor, bool active, uint8_t& sensors);
+
+    /**
+     * @brief Auslöser Reedkontakt: Sensorzustand = Pegel.
+     */
+    void triggerReed(size_t sensor, bool active, uint8_t& sensors);
+
+    /**
+     * @brief Auslöser Bewegungsmelder: aktive Flanke (re)startet die Haltezeit.
+     */
+    void triggerPir(size_t sensor, bool active, uint8_t& sensors);
+
+    /**
+     * @brief Auslöser Taster: kurzer Druck schaltet beim Loslassen um, langer Druck dimmt.
+     */
+    void triggerButton(size_t sensor, bool active, uint8_t& sensors);
+
+    /**
+     * @brief Beendet den Druck eines Tasters: Umschalten (kurz) oder Dimmstufe merken (lang).
+     * @param sensors Sensorzustand des aktuellen Ereignis-Batches
+     */
+    void releaseButton(size_t sensor, uint8_t& sensors);
+
+    /**
+     * @brief Prüft gedrückte Taster auf langen Druck und startet die Dimmrampe.
+     * @param sensors Sensorzustand des aktuellen Ereignis-Batches
+     */
+    void checkButtonHolds(uint8_t& sensors);
+
+    /**
+     * @brief Führt alle laufenden Dimmrampen zeitbasiert weiter (unabhängig von der Bildrate).
+     */
+    void stepRamps();
+
+    /**
+     * @brief Liest den aktuellen Pegel eines Sensors nach Polarity (true = aktiv).
+     */
+    bool readSensor(size_t sensor) const;
+
+    /**
+     * @brief Merkt eine Flanke und startet das Entprellfenster (neu), ggf. mit Vorglimmen.
+     */
+    void registerEdge(size_t sensor, absolute_time_t now);
+
+    /**
+     * @brief Übernimmt Sensorpegel, die seit DEBOUNCE_MS stabil sind.
+     * @param sensors Sensorzustand des aktuellen Ereignis-Batches
+     */
+    void settleSensors(uint8_t& sensors);
+
+    /**
+     * @brief Beendet das Vorglimmen eines Sensors: Fading übernimmt (bestätigt) oder Rücknahme (Prellen).
+     *
+     * @details Bestätigungen erst nach der Sensor-Kanal-Matrix auflösen: Nur Kanäle, die dabei eingeschaltet
+     *          wurden, übernehmen den Vorglimm-Pegel; alle anderen (z.B. UND-Regel mit geschlossenem Partner)
+     *          geben die Ebene ohne Ausblenden frei.
+     */
+    void resolveSpeculation(size_t sensor, bool confirmed);
+
+    /**
+     * @brief Deaktiviert Bewegungsmelder mit abgelaufener Haltezeit.
+     * @param sensors Sensorzustand des aktuellen Ereignis-Batches
+     */
+    void expirePirHolds(uint8_t& sensors);
+
+    /**
+     * @brief Wertet die Sensor-Kanal-Matrix für sensorActiveMask aus und schaltet geänderte Kanäle.
+     */
+    void applySensorMask();
+
+    /**
+     * @brief Schaltet Kanäle aus, deren Nachleuchten abgelaufen ist, und bestimmt afterglowNext neu.
+     */
+    void expireAfterglow();
+
+    /**
+     * @brief Bestimmt afterglowNext aus den laufenden Nachleucht-Zeiten.
+     */
+    void updateAfterglowNext();
+
+    /**
+     * @brief Prüft, ob LED-Pin bzw. Sensor-Pin eines Kanals noch wie initialisiert konfiguriert ist.
+     */
+    bool verifyLed(size_t idx) const;
+    bool verifySensor(size_t idx) const;
+
+    /**
+     * @brief Prüft alle Kanäle, initialisiert defekte erneut und aktualisiert die Fehlercode-Anzeige.
+     */
+    void checkHealth();
+
+    /**
+     * @brief Zeigt den niedrigsten Kanalfehler als Blinkcode an (bzw. beendet die Anzeige).
+     */
+    void updateStatusLed();
+
+    /**
+     * @brief Leitet channelSensorMask aus der Konfiguration ab und wertet die Matrix neu aus.
+     */
+    void applyConfig();
+
+    /**
+     * @brief Rechnet eine Fading-Dauer in eine Schrittweite pro Frame um (Q16).
+     * @param ms Dauer über den vollen Bereich (0 = Standard)
+     */
+    static uint32_t fadeStepQ16(uint16_t ms);
+
+    /**
+     * @brief Wertet alle Animationen in einem Durchlauf aus und schreibt ihre Ebenen.
+     */
+    void processAnimations();
+
+    /**
+     * @brief Ereignisstufe von process(): Sensoren, Entprellung, Auslöser, Matrix und Zeitsteuerung.
+     */
+    void sensorStage();
+
+    /**
+     * @brief Frame- und Ausgabestufe von process(): Fading, Animationen, Ausgabe, adaptive Bildrate.
+     */
+    void renderStage();
+
+    /**
+     * @brief Führt das Fading für alle Kanäle um die angegebene Anzahl Frames weiter.
+     * @param frames Anzahl der seit dem letzten Frame angefallenen Frame-Ticks
+     */
+    void stepFades(uint32_t frames);
+
+    /**
+     * @brief Gibt zurück, ob ein Kanal fadet oder eine laufende Animation hat.
+     */
+    bool isAnimating() const;
+
+    /**
+     * @brief Setzt den Fading-Pegel eines Kanals und markiert ihn bei Änderung in levelDirtyMask.
+     *
+     * @param idx   Kanalindex
+     * @param level Neuer Pegel (0..PWM_WRAP)
+     */
+    void setCurrentLevel(size_t idx, uint16_t level);
+
+    /**
+     * @brief Ausgabestufe: überträgt geänderte Pegel in die Ebenen und ruft commitOutputs() auf.
+     *
+     * @details Wird komplett übersprungen, wenn weder levelDirtyMask noch der Compositor Änderungen melden.
+     */
+    void renderOutputs();
+
+    /**
+     * @brief Commit-Stufe: verrechnet alle Ebenen und schreibt nur geänderte Kanäle in die PWM-Hardware.
+     */
+    void commitOutputs();
+
     /**
      * @brief Verarbeitet den GPIO-Interrupt für einen Sensor.
      *
@@ -492,4 +1319,27 @@ private:
     void onGpioIrq(uint gpio);
 };
 
+/**
+ * @brief Logmeldung mit Teilsystem und Ratenbegrenzung je Aufrufstelle.
+ *
+ * Beispiel: LOG_DEBUG(SENSOR, "sensor %d active=%d\n", i, active);
+ * Die Filterprüfung kostet wenige Zyklen; nur freigegebene Meldungen durchlaufen den Token-Bucket
+ * (LogRateLimiter) der Aufrufstelle und die Formatierung.
+ */
+#define CABINET_LOG(level, tag, ...)                                                                    \
+    do {                                                                                                \
+        if (CabinetLight::logEnabled(CabinetLight::LogLevel::level, CabinetLight::LogTag::tag)) {       \
+            static LogRateLimiter logLimiter_;                                                          \
+            uint32_t logSuppressed_;                                                                    \
+            if (logLimiter_.allow(logSuppressed_))                                                      \
+                CabinetLight::logTagged(CabinetLight::LogLevel::level, CabinetLight::LogTag::tag,       \
+                                        logSuppressed_, __VA_ARGS__);                                   \
+        }                                                                                               \
+    } while (0)
+
+#define LOG_ERROR(tag, ...) CABINET_LOG(ERROR, tag, __VA_ARGS__)
+#define LOG_WARN(tag, ...)  CABINET_LOG(WARN, tag, __VA_ARGS__)
+#define LOG_INFO(tag, ...)  CABINET_LOG(INFO, tag, __VA_ARGS__)
+#define LOG_DEBUG(tag, ...) CABINET_LOG(DEBUG, tag, __VA_ARGS__)
+
 #endif // CABINET_LIGHT_H
@@ -0,0 +1,173 @@
+/**
+ * @file crashReport.cpp
+ * @brief Implementierung der Absturzerfassung und des Startberichts.
+ *
+ * @author Knut Welzel <knut.welzel@gmail.com>
+ * @date 2025-09-13
+ * @copyright MIT
+ */
+
+#include "crashReport.h"
+#include "cabinetLight.h"               // Für Kanalzustand und Logging-API
+#include "pico/time.h"                  // Für time_us_32()
+#include "hardware/structs/scb.h"       // Für den System-Reset
+#include <cstring>                      // Für memset()
+
+// Datensatz im nicht initialisierten RAM (wird vom Startcode nicht gelöscht)
+static CrashReport::Record __uninitialized_ram(crashRecord);
+
+// SRAM-Bereich des RP2040 (264 KB) und XIP-Bereich für Zeiger auf String-Literale
+static constexpr uint32_t SRAM_BASE_ADDR = 0x20000000u;
+static constexpr uint32_t SRAM_END_ADDR  = 0x20042000u;
+static constexpr uint32_t XIP_BASE_ADDR  = 0x10000000u;
+static constexpr uint32_t XIP_END_ADDR   = 0x11000000u;
+
+// HardFault-Einsprung: aktiven Stack (MSP/PSP, Bit 2 von EXC_RETURN) bestimmen und an C++ übergeben
+// Cortex-M0+ (Thumb-1): keine IT-Blöcke, daher Verzweigung
+extern "C" __attribute__((naked, used)) void isr_hardfault(void) {
+    __asm volatile(
+        "movs r0, #4                \n"
+        "mov  r1, lr                \n"
+        "tst  r0, r1                \n"
+        "beq  1f                    \n"
+        "mrs  r0, psp               \n"
+        "b    2f                    \n"
+        "1:                         \n"
+        "mrs  r0, msp               \n"
+        "2:                         \n"
+        "ldr  r2, =cabinetHardFault \n"
+        "bx   r2                    \n"
+        ".ltorg                     \n");
+}
+
+// Datensatz schreiben und System-Reset auslösen (SRAM bleibt dabei erhalten)
+extern "C" __attribute__((used, noreturn)) void cabinetHardFault(const uint32_t* frame, uint32_t excReturn) {
+    CrashReport::captureFault(frame, excReturn);
+    scb_hw->aircr = (0x05FAu << M0PLUS_AIRCR_VECTKEY_LSB) | M0PLUS_AIRCR_SYSRESETREQ_BITS;
+    while (true) {}
+}
+
+bool CrashReport::inRam(uint32_t addr, size_t bytes) {
+    return addr >= SRAM_BASE_ADDR && addr <= SRAM_END_ADDR - bytes;
+}
+
+// FNV-1a über die Datenworte vor checksum
+uint32_t CrashReport::checksum(const Record& rec) {
+    const uint32_t* words = reinterpret_cast<const uint32_t*>(&rec);
+    uint32_t hash = 0x811C9DC5u;
+    for (size_t i = 0; i < offsetof(Record, checksum) / sizeof(uint32_t); ++i) {
+        hash = (hash ^ words[i]) * 16777619u;
+    }
+    return hash;
+}
+
+// Register aus dem Exception-Frame und Stackausschnitt nur lesen, wenn der Frame im SRAM liegt
+void CrashReport::captureFault(const uint32_t* frame, uint32_t excReturn) {
+    Record& rec = crashRecord;
+    uint32_t sp = reinterpret_cast<uintptr_t>(frame);
+    memset(rec.r, 0, sizeof(rec.r));
+    rec.r12 = rec.lr = rec.pc = rec.xpsr = 0;
+    memset(rec.stack, 0, sizeof(rec.stack));
+    if (inRam(sp, 8 * sizeof(uint32_t))) {
+        for (size_t i = 0; i < 4; ++i) rec.r[i] = frame[i];
+        rec.r12 = frame[4];
+        rec.lr = frame[5];
+        rec.pc = frame[6];
+        rec.xpsr = frame[7];
+        // Der Frame ist bei gesetztem Bit 9 in xPSR um ein Ausrichtungswort verschoben
+        sp += 8 * sizeof(uint32_t) + ((rec.xpsr & (1u << 9)) ? sizeof(uint32_t) : 0);
+        for (size_t i = 0; i < STACK_WORDS && inRam(sp + i * sizeof(uint32_t), sizeof(uint32_t)); ++i) {
+            rec.stack[i] = reinterpret_cast<const uint32_t*>(sp)[i];
+        }
+    }
+    rec.sp = sp;
+    rec.excReturn = excReturn;
+    captureCommon(Reason::HARDFAULT);
+}
+
+// Software-Fehler: Aufrufadresse statt Exception-Frame
+void CrashReport::recordFatal() {
+    Record& rec = crashRecord;
+    memset(rec.r, 0, sizeof(rec.r));
+    memset(rec.stack, 0, sizeof(rec.stack));
+    rec.r12 = rec.xpsr = rec.excReturn = 0;
+    rec.pc = reinterpret_cast<uintptr_t>(__builtin_return_address(0));
+    rec.lr = rec.pc;
+    rec.sp = reinterpret_cast<uintptr_t>(__builtin_frame_address(0));
+    captureCommon(Reason::FATAL);
+}
+
+void CrashReport::captureCommon(Reason reason) {
+    Record& rec = crashRecord;
+    if (rec.magic != MAGIC) {
+        rec.magic = MAGIC;
+        rec.crashCount = 0;
+    }
+    rec.reason = reason;
+    rec.uptimeUs = time_us_32();
+#ifdef CABINET_TRACE
+    rec.traceCount = Trace::copyLast(rec.trace, TRACE_EVENTS);
+#else
+    rec.traceCount = 0;     // Ohne Tracing keinen Verweis auf den Ringpuffer (ca. 3 KB RAM) erzeugen
+#endif
+
+    CabinetLight* light = CabinetLight::getInstance();
+    for (size_t c = 0; c < CHANNELS; ++c) {
+        rec.currentLevel[c] = light ? light->currentLevel[c] : 0;
+        rec.outputLevel[c] = light ? light->outputLevel[c] : 0;
+    }
+    rec.sensorActiveMask = light ? light->sensorActiveMask : 0;
+    rec.animationMask = light ? light->animationMask : 0;
+    rec.reserved = 0;
+    rec.checksum = checksum(rec);
+}
+
+// Kaltstart: Datensatz initialisieren; sonst einen offenen Absturz melden, zählen und als gemeldet markieren
+bool CrashReport::reportOnBoot() {
+    Record& rec = crashRecord;
+    if (rec.magic != MAGIC || rec.checksum != checksum(rec)) {
+        memset(&rec, 0, sizeof(rec));
+        rec.magic = MAGIC;
+        rec.checksum = checksum(rec);
+        return false;
+    }
+    if (rec.reason == Reason::NONE) return false;
+
+    ++rec.crashCount;
+    CabinetLight::logError("Absturz #%u: %s pc=0x%08x lr=0x%08x sp=0x%08x xpsr=0x%08x nach %u ms\n",
+                           static_cast<unsigned>(rec.crashCount),
+                           rec.reason == Reason::HARDFAULT ? "HardFault" : "Fatal",
+                           static_cast<unsigned>(rec.pc), static_cast<unsigned>(rec.lr),
+                           static_cast<unsigned>(rec.sp), static_cast<unsigned>(rec.xpsr),
+                           static_cast<unsigned>(rec.uptimeUs / 1000));
+    if (rec.reason == Reason::HARDFAULT) {
+        CabinetLight::logError("  r0=%08x r1=%08x r2=%08x r3=%08x r12=%08x exc=%08x\n",
+                               static_cast<unsigned>(rec.r[0]), static_cast<unsigned>(rec.r[1]),
+                               static_cast<unsigned>(rec.r[2]), static_cast<unsigned>(rec.r[3]),
+                               static_cast<unsigned>(rec.r12), static_cast<unsigned>(rec.excReturn));
+        for (size_t i = 0; i < STACK_WORDS; i += 4) {
+            CabinetLight::logError("  sp+%02x: %08x %08x %08x %08x\n", static_cast<unsigned>(i * 4),
+                                   static_cast<unsigned>(rec.stack[i]), static_cast<unsigned>(rec.stack[i + 1]),
+                                   static_cast<unsigned>(rec.stack[i + 2]), static_cast<unsigned>(rec.stack[i + 3]));
+        }
+    }
+    CabinetLight::logError("  Kanäle: level=%u,%u,%u,%u out=%u,%u,%u,%u sensors=0x%02x anim=0x%02x\n",
+                           rec.currentLevel[0], rec.currentLevel[1], rec.currentLevel[2], rec.currentLevel[3],
+                           rec.outputLevel[0], rec.outputLevel[1], rec.outputLevel[2], rec.outputLevel[3],
+                           rec.sensorActiveMask, rec.animationMask);
+    for (size_t i = 0; i < rec.traceCount && i < TRACE_EVENTS; ++i) {
+        const Trace::Event& ev = rec.trace[i];
+        uint32_t name = reinterpret_cast<uintptr_t>(ev.name);
+        CabinetLight::logError("  trace %u %c %u %s\n", static_cast<unsigned>(ev.timeUs), static_cast<char>(ev.phase),
+                               static_cast<unsigned>(ev.track),
+                               (name >= XIP_BASE_ADDR && name < XIP_END_ADDR) ? ev.name : "?");
+    }
+
+    rec.reason = Reason::NONE;
+    rec.checksum = checksum(rec);
+    return true;
+}
+
+uint32_t CrashReport::getCrashCount() {
+    return crashRecord.magic == MAGIC ? crashRecord.crashCount : 0;
+}
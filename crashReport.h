@@ -0,0 +1,133 @@
+/**
+ * @file crashReport.h
+ * @brief Absturzprotokoll im nicht initialisierten RAM mit Bericht beim nächsten Start (Header).
+ *
+ * Der HardFault-Handler (isr_hardfault) sichert Register, einen Ausschnitt des Stacks, die letzten
+ * Trace-Ereignisse (nur mit CABINET_TRACE) und den Zustand der Kanäle in einen Datensatz in der
+ * Sektion .uninitialized_data.
+ * Diese Sektion wird vom Startcode nicht gelöscht und überdauert daher einen Reset (nicht aber einen
+ * Spannungsausfall). Danach wird ein System-Reset ausgelöst.
+ *
+ * Beim nächsten Start gibt reportOnBoot() einen kompakten Bericht über die Logging-API aus und
+ * zählt die Abstürze. Der Aufwand beim Start ist eine Prüfsumme über den Datensatz (< 1 KB),
+ * es wird nicht gewartet.
+ *
+ * Zusätzlich protokolliert recordFatal() Software-Fehler (fatalErrorBlink) im selben Format.
+ *
+ * \author Knut Welzel <knut.welzel@gmail.com>
+ * \date 2025-09-13
+ * \copyright MIT
+ */
+
+#ifndef CRASH_REPORT_H
+#define CRASH_REPORT_H
+
+#include <cstdint>          // Für uint32_t
+#include <cstddef>          // Für size_t
+#include "trace.h"          // Für Trace::Event
+
+/**
+ * @class CrashReport
+ * @brief Statische Absturzerfassung und -auswertung.
+ */
+class CrashReport {
+
+public:
+    /**
+     * @brief Art des Absturzes.
+     */
+    enum class Reason : uint32_t {
+        NONE      = 0,  ///< Kein Absturz protokolliert
+        HARDFAULT = 1,  ///< HardFault (Register aus dem Exception-Frame)
+        FATAL     = 2   ///< Software-Fehler (fatalErrorBlink)
+    };
+
+    /**
+     * @brief Anzahl gesicherter Stackworte oberhalb des Exception-Frames.
+     */
+    static constexpr size_t STACK_WORDS = 16;
+
+    /**
+     * @brief Anzahl gesicherter Trace-Ereignisse.
+     */
+    static constexpr size_t TRACE_EVENTS = 8;
+
+    /**
+     * @brief Anzahl gesicherter Kanäle (entspricht CabinetLight::DEV_COUNT).
+     */
+    static constexpr size_t CHANNELS = 4;
+
+    /**
+     * @brief Kennung eines gültigen Datensatzes.
+     */
+    static constexpr uint32_t MAGIC = 0xC7A5E0F1u;
+
+    /**
+     * @brief Datensatz im nicht initialisierten RAM.
+     */
+    struct Record {
+        uint32_t magic;                         ///< MAGIC, sonst Inhalt ungültig (Kaltstart)
+        uint32_t crashCount;                    ///< Abstürze seit dem letzten Kaltstart
+        Reason reason;                          ///< Art des noch nicht gemeldeten Absturzes (NONE = gemeldet)
+        uint32_t r[4];                          ///< r0..r3
+        uint32_t r12, lr, pc, xpsr;             ///< Übrige Register des Exception-Frames
+        uint32_t sp;                            ///< Stackpointer vor der Exception
+        uint32_t excReturn;                     ///< EXC_RETURN (LR beim Eintritt in den Handler)
+        uint32_t uptimeUs;                      ///< time_us_32() zum Absturzzeitpunkt
+        uint32_t stack[STACK_WORDS];            ///< Stackausschnitt oberhalb des Frames
+        Trace::Event trace[TRACE_EVENTS];       ///< Letzte Trace-Ereignisse (älteste zuerst)
+        uint32_t traceCount;                    ///< Gültige Einträge in trace (0 ohne CABINET_TRACE)
+        uint16_t currentLevel[CHANNELS];        ///< Helligkeit je Kanal
+        uint16_t outputLevel[CHANNELS];         ///< Ausgegebener PWM-Wert je Kanal
+        uint8_t sensorActiveMask;               ///< Aktive Sensoren
+        uint8_t animationMask;                  ///< Kanäle mit laufender Animation
+        uint16_t reserved;                      ///< Ausrichtung
+        uint32_t checksum;                      ///< Prüfsumme über alle vorherigen Felder
+    };
+
+    /**
+     * @brief Gibt einen protokollierten Absturz als kompakten Bericht aus und zählt ihn.
+     *
+     * @details Einmal früh in main() nach der stdio-Initialisierung aufrufen. Bei einem Kaltstart
+     *          wird der Datensatz initialisiert.
+     *
+     * @return true, wenn ein Absturz gemeldet wurde
+     */
+    static bool reportOnBoot();
+
+    /**
+     * @brief Anzahl der Abstürze seit dem letzten Kaltstart.
+     */
+    static uint32_t getCrashCount();
+
+    /**
+     * @brief Protokolliert einen Software-Fehler (ohne Reset); Aufruf aus fatalErrorBlink().
+     */
+    static void recordFatal();
+
+    /**
+     * @brief Sichert einen HardFault (Aufruf aus isr_hardfault, nicht direkt verwenden).
+     *
+     * @param frame     Exception-Frame (r0, r1, r2, r3, r12, lr, pc, xpsr)
+     * @param excReturn EXC_RETURN
+     */
+    static void captureFault(const uint32_t* frame, uint32_t excReturn);
+
+private:
+    /**
+     * @brief Gemeinsamer Teil beider Erfassungen: Zeit, Trace, Kanäle, Zähler, Prüfsumme.
+     */
+    static void captureCommon(Reason reason);
+
+    /**
+     * @brief Prüfsumme über den Datensatz ohne das Feld checksum.
+     */
+    static uint32_t checksum(const Record& rec);
+
+    /**
+     * @brief Prüft, ob ein Adressbereich vollständig im SRAM liegt.
+     */
+    static bool inRam(uint32_t addr, size_t bytes);
+};
+
+#endif // CRASH_REPORT_H
@@ -0,0 +1,73 @@
+/**
+ * @file eventStats.cpp
+ * @brief Implementierung der Ereignisstatistik je Kanal.
+ *
+ * @author Knut Welzel <knut.welzel@gmail.com>
+ * @date 2025-09-13
+ * @copyright MIT
+ */
+
+#include "eventStats.h"
+
+// Zählt eine Öffnung
+void EventStats::recordOpen(size_t channel) {
+    if (channel >= CHANNELS) return;
+    beginWrite();
+    ++data.channels[channel].opens;
+    endWrite();
+}
+
+// Zählt einen Schließvorgang samt Öffnungsdauer
+void EventStats::recordClose(size_t channel, uint32_t openMs) {
+    if (channel >= CHANNELS) return;
+    Channel& ch = data.channels[channel];
+    beginWrite();
+    ++ch.closes;
+    ++ch.openDurationHist[durationBucket(openMs)];
+    if (openMs > ch.longestOpenMs) ch.longestOpenMs = openMs;
+    endWrite();
+}
+
+// Zählt verworfene Flanken
+void EventStats::recordBounces(size_t channel, uint32_t count) {
+    if (channel >= CHANNELS) return;
+    beginWrite();
+    data.channels[channel].bounces += count;
+    endWrite();
+}
+
+// Konsistente Kopie: Sequenzzähler vor und nach dem Kopieren muss gleich und gerade sein
+bool EventStats::snapshot(Snapshot& out) const {
+    for (int attempt = 0; attempt < SNAPSHOT_RETRIES; ++attempt) {
+        uint32_t before = sequence.load(std::memory_order_acquire);
+        if (before & 1u) continue;
+        out = data;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == before) return true;
+    }
+    return false;
+}
+
+// Setzt alle Zähler zurück
+void EventStats::reset() {
+    beginWrite();
+    data = {};
+    endWrite();
+}
+
+// log2-Klasse: 0 ms -> 0, 1 ms -> 1, 2..3 ms -> 2, 4..7 ms -> 3, ...
+size_t EventStats::durationBucket(uint32_t ms) {
+    size_t bits = ms ? static_cast<size_t>(32 - __builtin_clz(ms)) : 0;
+    return bits < DURATION_BUCKETS ? bits : DURATION_BUCKETS - 1;
+}
+
+// Sequenzzähler ungerade: Leser verwerfen ihre Kopie
+void EventStats::beginWrite() {
+    sequence.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+// Sequenzzähler wieder gerade: Daten sind konsistent
+void EventStats::endWrite() {
+    sequence.fetch_add(1, std::memory_order_release);
+}
@@ -0,0 +1,132 @@
+/**
+ * @file eventStats.h
+ * @brief Ereignisstatistik je Kanal: Öffnungen, Öffnungsdauer-Histogramm, Prellzähler (Header).
+ *
+ * Die Zähler werden im Ereignispfad der Hauptschleife mit konstantem Ganzzahlaufwand aktualisiert
+ * (keine Gleitkommazahlen, keine Schleifen). Die Öffnungsdauer wird in logarithmische Klassen
+ * einsortiert: Klasse k enthält Dauern von 2^(k-1) bis 2^k - 1 Millisekunden, die letzte Klasse
+ * alle längeren Dauern.
+ *
+ * \par Konsistente Abfrage
+ * Die Hauptschleife ist der einzige Schreiber. Leser (USB-Shell, Telemetrie, Kern 1) holen mit
+ * snapshot() eine konsistente Kopie über einen Sequenzzähler (Seqlock): Ein ungerader Zählerstand
+ * bedeutet "Schreiben läuft", ein geänderter Zählerstand nach dem Kopieren "erneut versuchen".
+ *
+ * \author Knut Welzel <knut.welzel@gmail.com>
+ * \date 2025-09-13
+ * \copyright MIT
+ */
+
+#ifndef EVENT_STATS_H
+#define EVENT_STATS_H
+
+#include <cstdint>          // Für uint32_t
+#include <cstddef>          // Für size_t
+#include <array>            // Für std::array
+#include <atomic>           // Für std::atomic
+
+/**
+ * @class EventStats
+ * @brief Nutzungsstatistik der Kanäle mit atomar abrufbarem Schnappschuss.
+ *
+ * \note Die record-Methoden dürfen nur aus der Hauptschleife aufgerufen werden, snapshot() aus jedem Kontext.
+ */
+class EventStats {
+
+public:
+    /**
+     * @brief Anzahl der Kanäle (entspricht CabinetLight::DEV_COUNT).
+     */
+    static constexpr size_t CHANNELS = 4;
+
+    /**
+     * @brief Anzahl der Klassen des Öffnungsdauer-Histogramms (letzte Klasse: ab 2^22 ms ≈ 70 min).
+     */
+    static constexpr size_t DURATION_BUCKETS = 24;
+
+    /**
+     * @brief Statistik eines Kanals.
+     */
+    struct Channel {
+        uint32_t opens;         ///< Anzahl der Öffnungen
+        uint32_t closes;        ///< Anzahl der Schließvorgänge (mit erfasster Dauer)
+        uint32_t bounces;       ///< Von der Entprellung verworfene Flanken am Sensoreingang gleichen Index
+        uint32_t longestOpenMs; ///< Längste Öffnungsdauer (ms)
+        std::array<uint32_t, DURATION_BUCKETS> openDurationHist;   ///< Öffnungsdauer, log2-Klassen in ms
+    };
+
+    /**
+     * @brief Schnappschuss aller Kanäle.
+     */
+    struct Snapshot {
+        std::array<Channel, CHANNELS> channels;
+    };
+
+    /**
+     * @brief Zählt eine Öffnung.
+     * @param channel Kanalindex
+     */
+    void recordOpen(size_t channel);
+
+    /**
+     * @brief Zählt einen Schließvorgang und sortiert die Öffnungsdauer in das Histogramm ein.
+     * @param channel Kanalindex
+     * @param openMs  Dauer der Öffnung in Millisekunden
+     */
+    void recordClose(size_t channel, uint32_t openMs);
+
+    /**
+     * @brief Zählt von der Entprellung verworfene Flanken.
+     * @param channel Kanalindex
+     * @param count   Anzahl der verworfenen Flanken
+     */
+    void recordBounces(size_t channel, uint32_t count);
+
+    /**
+     * @brief Liefert eine konsistente Kopie aller Zähler.
+     *
+     * @param out Ausgabe
+     * @return true bei Erfolg, false wenn während aller Versuche geschrieben wurde (z.B. Aufruf aus einem IRQ, der den Schreiber unterbrochen hat)
+     */
+    bool snapshot(Snapshot& out) const;
+
+    /**
+     * @brief Setzt alle Zähler zurück.
+     */
+    void reset();
+
+    /**
+     * @brief Histogrammklasse einer Dauer: Anzahl signifikanter Bits, begrenzt auf die letzte Klasse.
+     */
+    static size_t durationBucket(uint32_t ms);
+
+private:
+    /**
+     * @brief Maximale Anzahl der Leseversuche in snapshot().
+     */
+    static constexpr int SNAPSHOT_RETRIES = 4;
+
+    /**
+     * @brief Markiert den Beginn eines Schreibvorgangs (Sequenzzähler ungerade).
+     */
+    void beginWrite();
+
+    /**
+     * @brief Markiert das Ende eines Schreibvorgangs (Sequenzzähler wieder gerade).
+     */
+    void endWrite();
+
+    /**
+     * @brief Sequenzzähler des Seqlocks.
+     *
+     * @threadsafe
+     */
+    std::atomic<uint32_t> sequence {0};
+
+    /**
+     * @brief Zählerstände.
+     */
+    Snapshot data = {};
+};
+
+#endif // EVENT_STATS_H
@@ -0,0 +1,60 @@
+/**
+ * @file frameRenderer.cpp
+ * @brief Implementierung des adaptiven Frame-Taktgebers.
+ *
+ * @author Knut Welzel <knut.welzel@gmail.com>
+ * @date 2025-09-13
+ * @copyright MIT
+ */
+
+#include "frameRenderer.h"
+#include "hardware/sync.h"  // Für __sev()
+#include "loadMeter.h"      // Für die IRQ-Zeitmessung
+#include "trace.h"          // Für Trace-Ereignisse
+
+// Konstruktor: Frame-Periode aus der Bildrate berechnen
+FrameRenderer::FrameRenderer(uint32_t rateHz)
+    : framePeriodUs(1000000u / (rateHz ? rateHz : 1u)) {
+}
+
+// Timer-Callback im IRQ-Kontext: Tick zählen und Hauptschleife aus WFE wecken
+bool FrameRenderer::timerCallback(repeating_timer_t* rt) {
+    LoadMeter::Scope load(LoadMeter::Bucket::IRQ);
+    TRACE_INSTANT(IRQ, "frame");
+    FrameRenderer* self = static_cast<FrameRenderer*>(rt->user_data);
+    self->pendingTicks.fetch_add(1, std::memory_order_relaxed);
+    __sev();
+    return true;    // Timer weiterlaufen lassen
+}
+
+// Startet den Frame-Timer mit fester Periode (negativer Wert = Abstand zwischen den Startzeitpunkten)
+bool FrameRenderer::start() {
+    if (running) return true;
+    pendingTicks.store(0, std::memory_order_relaxed);
+    running = add_repeating_timer_us(-static_cast<int64_t>(framePeriodUs), timerCallback, this, &timer);
+    return running;
+}
+
+// Stoppt den Frame-Timer
+void FrameRenderer::stop() {
+    if (!running) return;
+    cancel_repeating_timer(&timer);
+    running = false;
+    pendingTicks.store(0, std::memory_order_relaxed);
+}
+
+// Holt aufgelaufene Ticks ab; mehrere Ticks werden zu einem Frame zusammengefasst
+uint32_t FrameRenderer::takeFrames() {
+    uint32_t ticks = pendingTicks.exchange(0, std::memory_order_acquire);
+    if (ticks > 1) stats.missedFrames += ticks - 1;
+    return ticks;
+}
+
+// Misst die Renderzeit eines Frames und zählt Überläufe
+void FrameRenderer::frameDone(uint32_t startUs) {
+    uint32_t duration = time_us_32() - startUs;
+    ++stats.frames;
+    stats.lastFrameUs = duration;
+    if (duration > stats.maxFrameUs) stats.maxFrameUs = duration;
+    if (duration > framePeriodUs) ++stats.overruns;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file frameRenderer.h
+ * @brief Frame-Taktgeber mit fester Bildrate für Fading und Animationen (Header).
+ *
+ * Ein Repeating-Timer des Pico-SDK erzeugt Frame-Ticks mit fester Rate (z.B. 200 Hz), solange
+ * mindestens ein Kanal fadet oder animiert ist. Sind alle Kanäle statisch, wird der Timer
+ * gestoppt und verursacht keine Aufweckvorgänge mehr. Die Hauptschleife holt die angefallenen
+ * Ticks mit takeFrames() ab und rendert genau einen Frame, auch wenn mehrere Ticks aufgelaufen sind.
+ *
+ * \par Statistik
+ * - frames:       gerenderte Frames
+ * - missedFrames: Ticks, die zusammengefasst wurden, weil die Hauptschleife zu spät kam
+ * - overruns:     Frames, deren Renderzeit länger als eine Frame-Periode war
+ *
+ * \author Knut Welzel <knut.welzel@gmail.com>
+ * \date 2025-09-13
+ * \copyright MIT
+ */
+
+#ifndef FRAME_RENDERER_H
+#define FRAME_RENDERER_H
+
+#include <cstdint>          // Für uint32_t
+#include <atomic>           // Für std::atomic
+#include "pico/time.h"      // Für repeating_timer_t
+
+/**
+ * @class FrameRenderer
+ * @brief Adaptiver Frame-Takt: feste Rate während Animationen, kein Timer im Leerlauf.
+ *
+ * \note Thread-Sicherheit: Der Timer-Callback läuft im IRQ-Kontext und schreibt nur den atomaren
+ * Tick-Zähler. Alle übrigen Methoden dürfen nur aus der Hauptschleife aufgerufen werden.
+ */
+class FrameRenderer {
+
+public:
+    /**
+     * @brief Frame-Statistik zur Abstimmung der Bildrate.
+     */
+    struct Stats {
+        uint32_t frames;        ///< Gerenderte Frames
+        uint32_t missedFrames;  ///< Zusammengefasste (verpasste) Frame-Ticks
+        uint32_t overruns;      ///< Frames mit Renderzeit > Frame-Periode
+        uint32_t lastFrameUs;   ///< Renderzeit des letzten Frames (µs)
+        uint32_t maxFrameUs;    ///< Maximale Renderzeit (µs)
+    };
+
+    /**
+     * @brief Konstruktor.
+     * @param rateHz Bildrate in Hz während aktiver Animationen
+     */
+    explicit FrameRenderer(uint32_t rateHz);
+
+    /**
+     * @brief Startet den Frame-Timer (ohne Wirkung, wenn er bereits läuft).
+     * @return true, wenn der Timer läuft
+     */
+    bool start();
+
+    /**
+     * @brief Stoppt den Frame-Timer (ohne Wirkung, wenn er bereits steht).
+     */
+    void stop();
+
+    /**
+     * @brief Gibt zurück, ob der Frame-Timer läuft.
+     */
+    bool isRunning() const { return running; }
+
+    /**
+     * @brief Holt die seit dem letzten Aufruf angefallenen Frame-Ticks ab.
+     *
+     * @return Anzahl der Ticks (0 = kein Frame fällig). Mehr als ein Tick zählt als verpasste Frames.
+     */
+    uint32_t takeFrames();
+
+    /**
+     * @brief Meldet das Ende eines Frames zur Messung der Renderzeit.
+     * @param startUs Zeitstempel (time_us_32()) zu Beginn des Frames
+     */
+    void frameDone(uint32_t startUs);
+
+    /**
+     * @brief Frame-Periode in Mikrosekunden.
+     */
+    uint32_t periodUs() const { return framePeriodUs; }
+
+    /**
+     * @brief Gibt eine Kopie der Frame-Statistik zurück.
+     */
+    Stats getStats() const { return stats; }
+
+    /**
+     * @brief Setzt die Frame-Statistik zurück.
+     */
+    void resetStats() { stats = {}; }
+
+private:
+    /**
+     * @brief Timer-Callback (IRQ-Kontext): zählt einen Tick und weckt die Hauptschleife.
+     */
+    static bool timerCallback(repeating_timer_t* rt);
+
+    /**
+     * @brief SDK-Timerstruktur.
+     */
+    repeating_timer_t timer = {};
+
+    /**
+     * @brief Frame-Periode (µs).
+     */
+    uint32_t framePeriodUs;
+
+    /**
+     * @brief Vom Timer-IRQ gezählte, noch nicht abgeholte Ticks.
+     *
+     * @threadsafe
+     */
+    std::atomic<uint32_t> pendingTicks {0};
+
+    /**
+     * @brief Gibt an, ob der Timer läuft.
+     */
+    bool running = false;
+
+    /**
+     * @brief Frame-Statistik.
+     */
+    Stats stats = {};
+};
+
+#endif // FRAME_RENDERER_H
@@ -0,0 +1,185 @@
+/**
+ * @file lightAnimation.cpp
+ * @brief Implementierung der Keyframe-Animations-Engine.
+ *
+ * Die Auswertung erfolgt rein mit Ganzzahl-/Festkomma-Arithmetik (Q16). Pro Frame fällt je
+ * laufendem Kanal genau eine Division an (Fortschritt innerhalb des Keyframes), die Skalierung
+ * der Pegel erfolgt über einen im Konstruktor berechneten Faktor.
+ *
+ * @author Knut Welzel <knut.welzel@gmail.com>
+ * @date 2025-09-13
+ * @copyright MIT
+ */
+
+#include "lightAnimation.h"
+
+// === Eingebaute Programme ===
+// Als static constexpr landen die Befehle in .rodata und damit im Flash (XIP).
+
+// Atmen: auf volle Helligkeit, dann endlos zwischen ca. 35 % und 100 %
+static constexpr LightAnimation::Op OPS_BREATHE[] = {
+    LightAnimation::key(255, 300, LightAnimation::Curve::EASE_OUT),
+    LightAnimation::key(90, 2500, LightAnimation::Curve::SMOOTH),
+    LightAnimation::key(255, 2500, LightAnimation::Curve::SMOOTH),
+    LightAnimation::loop(1)
+};
+
+// Puls: drei kurze Helligkeitsspitzen, danach Ende
+static constexpr LightAnimation::Op OPS_PULSE[] = {
+    LightAnimation::key(255, 150, LightAnimation::Curve::EASE_OUT),
+    LightAnimation::key(40, 350, LightAnimation::Curve::EASE_IN),
+    LightAnimation::loop(0, 2),
+    LightAnimation::end()
+};
+
+// Lauflicht: kurzes Aufleuchten, dann Pause bis zum nächsten Umlauf (Periode 1200 ms)
+static constexpr LightAnimation::Op OPS_CHASE[] = {
+    LightAnimation::key(255, 200, LightAnimation::Curve::EASE_OUT),
+    LightAnimation::key(0, 400, LightAnimation::Curve::EASE_IN),
+    LightAnimation::key(0, 600),
+    LightAnimation::loop(0)
+};
+
+const LightAnimation::Program LightAnimation::BREATHE = LightAnimation::program(OPS_BREATHE);
+const LightAnimation::Program LightAnimation::PULSE = LightAnimation::program(OPS_PULSE);
+const LightAnimation::Program LightAnimation::CHASE = LightAnimation::program(OPS_CHASE);
+
+// Konstruktor: Skalierungsfaktor für 8-Bit-Pegel vorab berechnen
+LightAnimation::LightAnimation(uint16_t maxLevel)
+    : levelScaleQ16((static_cast<uint32_t>(maxLevel) << 16) / 255u) {
+}
+
+// Startet ein Programm auf einem Kanal
+bool LightAnimation::start(size_t channel, const Program& program, uint16_t startLevel, uint32_t startMs) {
+    if (channel >= CHANNELS || !program.ops || program.length == 0) return false;
+
+    Channel& ch = channels[channel];
+    ch.ops = program.ops;
+    ch.length = program.length;
+    ch.pc = 0;
+    ch.curve = 0;
+    ch.loopLeft = LOOP_IDLE;
+    ch.from = startLevel;
+    ch.to = startLevel;
+    ch.duration = 0;        // Erster Keyframe wird im nächsten tick() geladen
+    ch.startMs = startMs;
+
+    uint8_t bit = static_cast<uint8_t>(1u << channel);
+    runMask |= bit;
+    holdMask &= static_cast<uint8_t>(~bit);
+    return true;
+}
+
+// Stoppt das Programm eines Kanals
+void LightAnimation::stop(size_t channel) {
+    if (channel >= CHANNELS) return;
+    uint8_t bit = static_cast<uint8_t>(1u << channel);
+    runMask &= static_cast<uint8_t>(~bit);
+    holdMask &= static_cast<uint8_t>(~bit);
+    channels[channel].ops = nullptr;
+}
+
+// Lädt den nächsten Keyframe; Sprünge und Steuerbefehle werden direkt abgearbeitet
+LightAnimation::Fetch LightAnimation::fetch(Channel& ch) const {
+    // Schutz gegen Programme, die ohne Keyframe endlos springen
+    for (uint16_t guard = 0; guard <= ch.length; ++guard) {
+        if (ch.pc >= ch.length) return Fetch::END;     // Implizites END am Programmende
+
+        const Op op = ch.ops[ch.pc];
+        switch (op.code & 0xF0) {
+        case OP_KEY:
+            ch.from = ch.to;
+            ch.to = static_cast<uint16_t>((op.level * levelScaleQ16) >> 16);
+            ch.duration = op.arg;
+            ch.curve = op.code & 0x0F;
+            ++ch.pc;
+            return Fetch::KEY;
+
+        case OP_LOOP:
+            if (op.arg == 0) {
+                ch.pc = op.level;                       // Endlosschleife
+            } else {
+                if (ch.loopLeft == LOOP_IDLE) ch.loopLeft = op.arg;
+                if (ch.loopLeft > 0) {
+                    --ch.loopLeft;
+                    ch.pc = op.level;
+                } else {
+                    ch.loopLeft = LOOP_IDLE;            // Schleife fertig, weiter
+                    ++ch.pc;
+                }
+            }
+            break;
+
+        case OP_HOLD:
+            return Fetch::HOLD;
+
+        default:
+            return Fetch::END;
+        }
+    }
+    return Fetch::HOLD;
+}
+
+// Kurvenfunktionen auf Q16-Fortschritt t (0..65535); Zwischenwerte bleiben in 32 Bit
+uint32_t LightAnimation::applyCurve(uint8_t curve, uint32_t t) {
+    switch (static_cast<Curve>(curve)) {
+    case Curve::EASE_IN:
+        return ((t >> 1) * (t >> 1)) >> 14;
+    case Curve::EASE_OUT: {
+        uint32_t inv = 65536u - t;
+        return 65536u - (((inv >> 1) * (inv >> 1)) >> 14);
+    }
+    case Curve::SMOOTH: {
+        // t² · (3 - 2t)
+        uint32_t sq = ((t >> 1) * (t >> 1)) >> 14;
+        return ((sq >> 2) * ((3u * 65536u - 2u * t) >> 2)) >> 12;
+    }
+    default:
+        return t;
+    }
+}
+
+// Wertet alle belegten Kanäle in einem Durchlauf aus
+uint8_t LightAnimation::tick(uint32_t nowMs, std::array<uint16_t, CHANNELS>& levels) {
+    // Haltende Kanäle liefern ihren letzten Pegel
+    for (size_t i = 0; i < CHANNELS; ++i) {
+        if (holdMask & (1u << i)) levels[i] = channels[i].to;
+    }
+
+    for (size_t i = 0; i < CHANNELS; ++i) {
+        uint8_t bit = static_cast<uint8_t>(1u << i);
+        if (!(runMask & bit)) continue;
+
+        Channel& ch = channels[i];
+        int32_t elapsed = static_cast<int32_t>(nowMs - ch.startMs);   // Überlaufsicher
+        if (elapsed < 0) {
+            levels[i] = ch.from;                    // Verzögerter Start
+            continue;
+        }
+
+        // Abgelaufene Keyframes überspringen (auch bei verpassten Frames)
+        Fetch state = Fetch::KEY;
+        uint16_t guard = ch.length + 1u;
+        while (static_cast<uint32_t>(elapsed) >= ch.duration) {
+            elapsed -= ch.duration;
+            ch.startMs += ch.duration;
+            state = guard-- ? fetch(ch) : Fetch::HOLD;
+            if (state != Fetch::KEY) break;
+        }
+
+        if (state == Fetch::KEY) {
+            // Fortschritt im Keyframe als Q16 (elapsed < duration <= 65535)
+            uint32_t t = (static_cast<uint32_t>(elapsed) << 16) / ch.duration;
+            int32_t delta = static_cast<int32_t>(ch.to) - static_cast<int32_t>(ch.from);
+            int32_t step = (delta * static_cast<int32_t>(applyCurve(ch.curve, t) >> 1)) >> 15;
+            levels[i] = static_cast<uint16_t>(static_cast<int32_t>(ch.from) + step);
+            continue;
+        }
+
+        levels[i] = ch.to;
+        runMask &= static_cast<uint8_t>(~bit);
+        if (state == Fetch::HOLD) holdMask |= bit;
+        else ch.ops = nullptr;
+    }
+    return runMask | holdMask;
+}
@@ -0,0 +1,252 @@
+/**
+ * @file lightAnimation.h
+ * @brief Keyframe-Animations-Engine für die LED-Kanäle (Header).
+ *
+ * Jeder Kanal führt ein kompaktes, vorkompiliertes Keyframe-Programm aus (Bytecode mit
+ * 4 Byte pro Befehl). Die Programme liegen als konstante Arrays im Flash, die Laufzeitdaten
+ * pro Kanal umfassen nur wenige Bytes. Alle Kanäle werden in einem einzigen Durchlauf pro
+ * Frame mit Festkomma-Arithmetik ausgewertet – ohne Heap und ohne Fließkomma.
+ *
+ * \par Befehlssatz
+ * - KEY:  Überblende in @c duration Millisekunden auf @c level (0..255) mit Kurve
+ * - LOOP: Springe zu Befehl @c target, @c count Wiederholungen (0 = endlos)
+ * - HOLD: Letzten Pegel halten (Kanal bleibt belegt, aber statisch)
+ * - END:  Programm beenden (Kanal wird freigegeben)
+ *
+ * \par Beispiel
+ * \code{.cpp}
+ * static constexpr LightAnimation::Op BLINK[] = {
+ *     LightAnimation::key(255, 200),
+ *     LightAnimation::key(0, 200),
+ *     LightAnimation::loop(0, 3),
+ *     LightAnimation::end()
+ * };
+ * animation.start(0, LightAnimation::program(BLINK), 0, nowMs);
+ * \endcode
+ *
+ * \author Knut Welzel <knut.welzel@gmail.com>
+ * \date 2025-09-13
+ * \copyright MIT
+ */
+
+#ifndef LIGHT_ANIMATION_H
+#define LIGHT_ANIMATION_H
+
+#include <cstdint>          // Für uint8_t, uint16_t, uint32_t
+#include <cstddef>          // Für size_t
+#include <array>            // Für std::array
+
+/**
+ * @class LightAnimation
+ * @brief Kleine Animations-VM: ein Keyframe-Programm pro LED-Kanal.
+ *
+ * @details Die Engine kennt nur Pegel im Bereich 0..maxLevel (typisch PWM_WRAP). Die 8-Bit-Pegel
+ * der Programme werden beim Laden eines Keyframes über einen vorab berechneten Q16-Faktor
+ * skaliert, sodass pro Frame keine Division für die Skalierung anfällt.
+ *
+ * \note Nicht thread-safe. tick(), start() und stop() dürfen nur aus der Hauptschleife aufgerufen werden.
+ */
+class LightAnimation {
+
+public:
+    /**
+     * @brief Maximale Anzahl der Kanäle (entspricht CabinetLight::DEV_COUNT).
+     */
+    static constexpr size_t CHANNELS = 4;
+
+    /**
+     * @brief Interpolationskurve eines Keyframes.
+     */
+    enum class Curve : uint8_t {
+        LINEAR   = 0,   ///< Lineare Überblendung
+        EASE_IN  = 1,   ///< Langsamer Start (quadratisch)
+        EASE_OUT = 2,   ///< Langsames Ende (quadratisch)
+        SMOOTH   = 3    ///< Smoothstep (weicher Start und weiches Ende)
+    };
+
+    /**
+     * @brief Ein Bytecode-Befehl (4 Byte).
+     *
+     * @details @c code enthält im oberen Nibble den Opcode, im unteren Nibble die Kurve.
+     * Die Bedeutung von @c level und @c arg hängt vom Opcode ab (siehe key(), loop()).
+     */
+    struct Op {
+        uint8_t code;       ///< Opcode (oberes Nibble) und Kurve (unteres Nibble)
+        uint8_t level;      ///< KEY: Zielpegel 0..255, LOOP: Sprungziel
+        uint16_t arg;       ///< KEY: Dauer in ms, LOOP: Anzahl Wiederholungen
+    };
+    static_assert(sizeof(Op) == 4, "LightAnimation::Op muss 4 Byte groß sein");
+
+    /**
+     * @brief Verweis auf ein Programm im Flash.
+     */
+    struct Program {
+        const Op* ops;      ///< Erster Befehl
+        uint8_t length;     ///< Anzahl der Befehle
+    };
+
+    // === Opcodes (oberes Nibble von Op::code) ===
+    static constexpr uint8_t OP_KEY  = 0x00;
+    static constexpr uint8_t OP_LOOP = 0x10;
+    static constexpr uint8_t OP_HOLD = 0x20;
+    static constexpr uint8_t OP_END  = 0x30;
+
+    /**
+     * @brief Erzeugt einen Keyframe-Befehl.
+     * @param level Zielpegel (0..255, wird auf maxLevel skaliert)
+     * @param ms    Dauer der Überblendung in Millisekunden
+     * @param curve Interpolationskurve
+     */
+    static constexpr Op key(uint8_t level, uint16_t ms, Curve curve = Curve::LINEAR) {
+        return Op{ static_cast<uint8_t>(OP_KEY | static_cast<uint8_t>(curve)), level, ms };
+    }
+
+    /**
+     * @brief Erzeugt einen Schleifen-Befehl.
+     * @param target Index des Befehls, zu dem gesprungen wird
+     * @param count  Anzahl der Wiederholungen (0 = endlos)
+     *
+     * @details Pro Kanal gibt es genau einen Schleifenzähler, Schleifen dürfen nicht verschachtelt werden.
+     */
+    static constexpr Op loop(uint8_t target, uint16_t count = 0) {
+        return Op{ OP_LOOP, target, count };
+    }
+
+    /**
+     * @brief Erzeugt einen HOLD-Befehl (letzten Pegel dauerhaft halten).
+     */
+    static constexpr Op hold() { return Op{ OP_HOLD, 0, 0 }; }
+
+    /**
+     * @brief Erzeugt einen END-Befehl (Programm beenden, Kanal freigeben).
+     */
+    static constexpr Op end() { return Op{ OP_END, 0, 0 }; }
+
+    /**
+     * @brief Erzeugt einen Program-Verweis aus einem konstanten Befehlsarray.
+     */
+    template <size_t N>
+    static constexpr Program program(const Op (&ops)[N]) {
+        static_assert(N > 0 && N <= 255, "Programmlänge muss 1..255 sein");
+        return Program{ ops, static_cast<uint8_t>(N) };
+    }
+
+    // === Eingebaute Programme (im Flash) ===
+
+    /**
+     * @brief Langsames Atmen zwischen voller und reduzierter Helligkeit (endlos).
+     */
+    static const Program BREATHE;
+
+    /**
+     * @brief Drei kurze Pulse, danach Ende (z.B. als Warnhinweis).
+     */
+    static const Program PULSE;
+
+    /**
+     * @brief Lauflicht-Schritt mit 1200 ms Periode (endlos).
+     *
+     * @details Wird auf allen Kanälen mit einem Versatz von 300 ms gestartet (siehe CabinetLight::startChase()).
+     */
+    static const Program CHASE;
+
+    /**
+     * @brief Konstruktor.
+     * @param maxLevel Pegel, der dem Programmwert 255 entspricht (z.B. PWM_WRAP)
+     */
+    explicit LightAnimation(uint16_t maxLevel);
+
+    /**
+     * @brief Startet ein Programm auf einem Kanal.
+     *
+     * @param channel    Kanalindex (0..CHANNELS-1)
+     * @param program    Programm im Flash
+     * @param startLevel Aktueller Pegel des Kanals (Ausgangspunkt des ersten Keyframes)
+     * @param startMs    Startzeitpunkt in ms seit Boot (darf in der Zukunft liegen)
+     * @return true bei Erfolg, false bei ungültigem Kanal oder leerem Programm
+     */
+    bool start(size_t channel, const Program& program, uint16_t startLevel, uint32_t startMs);
+
+    /**
+     * @brief Stoppt das Programm eines Kanals sofort.
+     * @param channel Kanalindex
+     */
+    void stop(size_t channel);
+
+    /**
+     * @brief Wertet alle laufenden Kanäle in einem Durchlauf aus.
+     *
+     * @param nowMs  Aktuelle Zeit in ms seit Boot
+     * @param levels Ausgabe: berechneter Pegel je Kanal (nur für Kanäle in der Rückgabemaske gültig)
+     * @return Bitmaske der Kanäle, die weiterhin von einer Animation belegt sind
+     */
+    uint8_t tick(uint32_t nowMs, std::array<uint16_t, CHANNELS>& levels);
+
+    /**
+     * @brief Bitmaske der belegten Kanäle (laufend oder haltend).
+     */
+    uint8_t activeMask() const { return runMask | holdMask; }
+
+    /**
+     * @brief Bitmaske der Kanäle, deren Pegel sich noch zeitlich ändert.
+     */
+    uint8_t animatingMask() const { return runMask; }
+
+private:
+    /**
+     * @brief Laufzeitzustand eines Kanals.
+     */
+    struct Channel {
+        const Op* ops = nullptr;    ///< Programm
+        uint8_t length = 0;         ///< Programmlänge
+        uint8_t pc = 0;             ///< Nächster Befehl
+        uint8_t curve = 0;          ///< Kurve des aktuellen Keyframes
+        uint16_t loopLeft = 0;      ///< Verbleibende Wiederholungen (LOOP_IDLE = inaktiv)
+        uint16_t from = 0;          ///< Startpegel des aktuellen Keyframes
+        uint16_t to = 0;            ///< Zielpegel des aktuellen Keyframes
+        uint16_t duration = 0;      ///< Dauer des aktuellen Keyframes (ms)
+        uint32_t startMs = 0;       ///< Startzeit des aktuellen Keyframes (ms seit Boot)
+    };
+
+    /**
+     * @brief Markierung für einen nicht aktiven Schleifenzähler.
+     */
+    static constexpr uint16_t LOOP_IDLE = 0xFFFF;
+
+    /**
+     * @brief Ergebnis von fetch(): Zustand nach dem Laden des nächsten Befehls.
+     */
+    enum class Fetch : uint8_t { KEY, HOLD, END };
+
+    /**
+     * @brief Lädt den nächsten Keyframe (verarbeitet LOOP/HOLD/END).
+     */
+    Fetch fetch(Channel& ch) const;
+
+    /**
+     * @brief Wendet die Kurve auf einen Q16-Fortschritt an.
+     */
+    static uint32_t applyCurve(uint8_t curve, uint32_t t);
+
+    /**
+     * @brief Skalierungsfaktor 0..255 -> 0..maxLevel (Q16).
+     */
+    uint32_t levelScaleQ16;
+
+    /**
+     * @brief Laufzeitzustände aller Kanäle.
+     */
+    std::array<Channel, CHANNELS> channels = {};
+
+    /**
+     * @brief Kanäle mit laufendem Keyframe.
+     */
+    uint8_t runMask = 0;
+
+    /**
+     * @brief Kanäle, die per HOLD einen statischen Pegel halten.
+     */
+    uint8_t holdMask = 0;
+};
+
+#endif // LIGHT_ANIMATION_H
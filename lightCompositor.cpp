@@ -0,0 +1,140 @@
+/**
+ * @file lightCompositor.cpp
+ * @brief Implementierung des Ebenen-Compositors.
+ *
+ * Die Verrechnung läuft nur für Kanäle mit geänderten Ebenen. MULTIPLY verwendet einen im
+ * Konstruktor berechneten Kehrwert (Q24), sodass pro Frame keine Division anfällt.
+ *
+ * @author Knut Welzel <knut.welzel@gmail.com>
+ * @date 2025-09-13
+ * @copyright MIT
+ */
+
+#include "lightCompositor.h"
+
+// Konstruktor: Standard-Blend-Modi und Prioritäten setzen
+LightCompositor::LightCompositor(uint16_t maxLevel)
+    : invMaxQ24((1u << 24) / (maxLevel ? maxLevel : 1u)) {
+
+    blend[static_cast<size_t>(Layer::DOOR)]         = Blend::MAX;
+    blend[static_cast<size_t>(Layer::SPECULATIVE)]  = Blend::MAX;
+    blend[static_cast<size_t>(Layer::ANIMATION)]    = Blend::OVERRIDE;
+    blend[static_cast<size_t>(Layer::WARNING)]      = Blend::MULTIPLY;
+    blend[static_cast<size_t>(Layer::STARTUP_TEST)] = Blend::OVERRIDE;
+    blend[static_cast<size_t>(Layer::MANUAL)]       = Blend::OVERRIDE;
+
+    // Standard-Priorität entspricht der Reihenfolge der Layer-Enumeration
+    for (size_t l = 0; l < LAYER_COUNT; ++l) {
+        priority[l] = static_cast<uint8_t>(l);
+    }
+    rebuildOrder();
+
+    // Die Tür-Ebene ist immer aktiv (Basis der Verrechnung)
+    active.fill(static_cast<uint8_t>(1u << static_cast<size_t>(Layer::DOOR)));
+}
+
+// Setzt den Pegel einer Ebene und aktiviert sie
+void LightCompositor::setLevel(size_t channel, Layer layer, uint16_t level) {
+    if (channel >= CHANNELS) return;
+    size_t l = static_cast<size_t>(layer);
+    uint8_t bit = static_cast<uint8_t>(1u << l);
+    if ((active[channel] & bit) && levels[channel][l] == level) return;   // Keine Änderung
+
+    levels[channel][l] = level;
+    active[channel] |= bit;
+    dirty |= static_cast<uint8_t>(1u << channel);
+}
+
+// Deaktiviert eine Ebene eines Kanals
+void LightCompositor::release(size_t channel, Layer layer) {
+    if (channel >= CHANNELS || layer == Layer::DOOR) return;   // Basis bleibt aktiv
+    uint8_t bit = static_cast<uint8_t>(1u << static_cast<size_t>(layer));
+    if (!(active[channel] & bit)) return;
+
+    active[channel] &= static_cast<uint8_t>(~bit);
+    dirty |= static_cast<uint8_t>(1u << channel);
+}
+
+// Gibt zurück, ob eine Ebene aktiv ist
+bool LightCompositor::isActive(size_t channel, Layer layer) const {
+    if (channel >= CHANNELS) return false;
+    return active[channel] & (1u << static_cast<size_t>(layer));
+}
+
+// Setzt den Blend-Modus einer Ebene; alle Kanäle mit aktiver Ebene neu verrechnen
+void LightCompositor::setBlend(Layer layer, Blend mode) {
+    size_t l = static_cast<size_t>(layer);
+    if (blend[l] == mode) return;
+    blend[l] = mode;
+    for (size_t c = 0; c < CHANNELS; ++c) {
+        if (active[c] & (1u << l)) dirty |= static_cast<uint8_t>(1u << c);
+    }
+}
+
+// Setzt die Priorität einer Ebene und sortiert die Reihenfolge neu
+void LightCompositor::setPriority(Layer layer, uint8_t prio) {
+    priority[static_cast<size_t>(layer)] = prio;
+    rebuildOrder();
+    dirty = static_cast<uint8_t>((1u << CHANNELS) - 1u);
+}
+
+// Markiert die Ausgabe eines Kanals als neu zu schreiben
+void LightCompositor::invalidate(size_t channel, uint16_t hwLevel) {
+    if (channel >= CHANNELS) return;
+    result[channel] = hwLevel;
+    dirty |= static_cast<uint8_t>(1u << channel);
+}
+
+// Sortiert die Ebenen stabil nach Priorität (Insertion-Sort, nur bei Konfigurationsänderung)
+void LightCompositor::rebuildOrder() {
+    for (size_t l = 0; l < LAYER_COUNT; ++l) {
+        order[l] = static_cast<uint8_t>(l);
+    }
+    for (size_t i = 1; i < LAYER_COUNT; ++i) {
+        uint8_t cur = order[i];
+        size_t j = i;
+        while (j > 0 && priority[order[j - 1]] > priority[cur]) {
+            order[j] = order[j - 1];
+            --j;
+        }
+        order[j] = cur;
+    }
+}
+
+// Verrechnet alle geänderten Kanäle und meldet geänderte Ergebnisse
+uint8_t LightCompositor::compose(std::array<uint16_t, CHANNELS>& out) {
+    if (!dirty) return 0;
+
+    uint8_t changed = 0;
+    for (size_t c = 0; c < CHANNELS; ++c) {
+        uint8_t bit = static_cast<uint8_t>(1u << c);
+        if (!(dirty & bit)) continue;
+
+        uint32_t level = 0;
+        for (uint8_t l : order) {
+            if (!(active[c] & (1u << l))) continue;
+            uint32_t v = levels[c][l];
+            switch (blend[l]) {
+            case Blend::MAX:
+                if (v > level) level = v;
+                break;
+            case Blend::OVERRIDE:
+                level = v;
+                break;
+            case Blend::MULTIPLY:
+                // Faktor v/maxLevel als Q16, dann skalieren
+                level = (level * ((v * invMaxQ24) >> 8)) >> 16;
+                break;
+            }
+        }
+
+        uint16_t composed = static_cast<uint16_t>(level);
+        if (composed != result[c]) {
+            result[c] = composed;
+            changed |= bit;
+        }
+        out[c] = composed;
+    }
+    dirty = 0;
+    return changed;
+}
@@ -0,0 +1,186 @@
+/**
+ * @file lightCompositor.h
+ * @brief Ebenen-Compositor für überlagerte Helligkeitsanforderungen (Header).
+ *
+ * Mehrere Quellen (Türzustand, spekulatives Vorglimmen, Animationen, Warnhinweis, Startup-Test, manuelle Übersteuerung)
+ * dürfen denselben Kanal gleichzeitig ansteuern. Jede Quelle schreibt in ihre eigene Ebene,
+ * der Compositor verrechnet die aktiven Ebenen eines Kanals in Prioritätsreihenfolge mit dem
+ * jeweiligen Blend-Modus zu einem Ausgangspegel.
+ *
+ * \par Blend-Modi
+ * - MAX:      Ausgang = max(Ausgang, Ebene)
+ * - OVERRIDE: Ausgang = Ebene
+ * - MULTIPLY: Ausgang = Ausgang · Ebene / maxLevel
+ *
+ * Die Verrechnung erfolgt nur für Kanäle, bei denen sich seit dem letzten compose() eine
+ * Ebene geändert hat (Dirty-Maske).
+ *
+ * \author Knut Welzel <knut.welzel@gmail.com>
+ * \date 2025-09-13
+ * \copyright MIT
+ */
+
+#ifndef LIGHT_COMPOSITOR_H
+#define LIGHT_COMPOSITOR_H
+
+#include <cstdint>          // Für uint8_t, uint16_t, uint32_t
+#include <cstddef>          // Für size_t
+#include <array>            // Für std::array
+
+/**
+ * @class LightCompositor
+ * @brief Ebenen-Stapel mit Prioritäten und Blend-Modi pro Kanal.
+ *
+ * \note Nicht thread-safe. Alle Methoden dürfen nur aus der Hauptschleife aufgerufen werden.
+ */
+class LightCompositor {
+
+public:
+    /**
+     * @brief Maximale Anzahl der Kanäle (entspricht CabinetLight::DEV_COUNT).
+     */
+    static constexpr size_t CHANNELS = 4;
+
+    /**
+     * @brief Verrechnungsart einer Ebene mit dem Ergebnis der darunterliegenden Ebenen.
+     */
+    enum class Blend : uint8_t {
+        MAX      = 0,   ///< Hellster Wert gewinnt
+        OVERRIDE = 1,   ///< Ebene ersetzt das bisherige Ergebnis
+        MULTIPLY = 2    ///< Ebene skaliert das bisherige Ergebnis
+    };
+
+    /**
+     * @brief Ebenen (Quellen), in Standard-Priorität aufsteigend.
+     */
+    enum class Layer : uint8_t {
+        DOOR         = 0,   ///< Türzustand inkl. Fading (Basis, immer aktiv)
+        SPECULATIVE  = 1,   ///< Vorglimmen nach der ersten Flanke, bis die Entprellung bestätigt
+        ANIMATION    = 2,   ///< Effekte wie Atmen oder Lauflicht
+        WARNING      = 3,   ///< Warnhinweise (z.B. Puls)
+        STARTUP_TEST = 4,   ///< Startup-Test der LEDs
+        MANUAL       = 5,   ///< Manuelle Übersteuerung
+        COUNT        = 6    ///< Anzahl der Ebenen
+    };
+
+    /**
+     * @brief Anzahl der Ebenen.
+     */
+    static constexpr size_t LAYER_COUNT = static_cast<size_t>(Layer::COUNT);
+    static_assert(LAYER_COUNT <= 8, "Aktive Ebenen werden als uint8_t-Bitmaske geführt");
+
+    /**
+     * @brief Konstruktor.
+     * @param maxLevel Maximaler Pegel (z.B. PWM_WRAP), Bezugsgröße für MULTIPLY
+     */
+    explicit LightCompositor(uint16_t maxLevel);
+
+    /**
+     * @brief Setzt den Pegel einer Ebene und aktiviert sie.
+     *
+     * @param channel Kanalindex
+     * @param layer   Ebene
+     * @param level   Pegel (0..maxLevel)
+     *
+     * @details Markiert den Kanal nur dann als geändert, wenn sich Pegel oder Aktivzustand ändern.
+     */
+    void setLevel(size_t channel, Layer layer, uint16_t level);
+
+    /**
+     * @brief Deaktiviert eine Ebene eines Kanals.
+     * @param channel Kanalindex
+     * @param layer   Ebene
+     */
+    void release(size_t channel, Layer layer);
+
+    /**
+     * @brief Gibt zurück, ob eine Ebene eines Kanals aktiv ist.
+     */
+    bool isActive(size_t channel, Layer layer) const;
+
+    /**
+     * @brief Setzt den Blend-Modus einer Ebene (für alle Kanäle).
+     */
+    void setBlend(Layer layer, Blend blend);
+
+    /**
+     * @brief Gibt den Blend-Modus einer Ebene zurück.
+     */
+    Blend getBlend(Layer layer) const { return blend[static_cast<size_t>(layer)]; }
+
+    /**
+     * @brief Setzt die Priorität einer Ebene (höher = später verrechnet).
+     *
+     * @details Die Verrechnungsreihenfolge wird hier einmalig sortiert, nicht pro Frame.
+     */
+    void setPriority(Layer layer, uint8_t priority);
+
+    /**
+     * @brief Markiert die Ausgabe eines Kanals als unbekannt (z.B. nach Neuinitialisierung der PWM).
+     *
+     * @param channel Kanalindex
+     * @param hwLevel Aktuell in der Hardware gesetzter Pegel
+     */
+    void invalidate(size_t channel, uint16_t hwLevel);
+
+    /**
+     * @brief Verrechnet alle geänderten Kanäle.
+     *
+     * @param out Ausgabe: resultierender Pegel je Kanal (nur geänderte Einträge werden geschrieben)
+     * @return Bitmaske der Kanäle, deren Ergebnis sich geändert hat
+     */
+    uint8_t compose(std::array<uint16_t, CHANNELS>& out);
+
+    /**
+     * @brief Bitmaske der Kanäle mit geänderten Ebenen seit dem letzten compose().
+     */
+    uint8_t dirtyMask() const { return dirty; }
+
+private:
+    /**
+     * @brief Sortiert die Verrechnungsreihenfolge nach Priorität.
+     */
+    void rebuildOrder();
+
+    /**
+     * @brief Pegel je Kanal und Ebene.
+     */
+    std::array<std::array<uint16_t, LAYER_COUNT>, CHANNELS> levels = {};
+
+    /**
+     * @brief Aktive Ebenen je Kanal (Bit n = Layer n).
+     */
+    std::array<uint8_t, CHANNELS> active = {};
+
+    /**
+     * @brief Blend-Modus je Ebene.
+     */
+    std::array<Blend, LAYER_COUNT> blend = {};
+
+    /**
+     * @brief Priorität je Ebene.
+     */
+    std::array<uint8_t, LAYER_COUNT> priority = {};
+
+    /**
+     * @brief Ebenen in Verrechnungsreihenfolge (niedrigste Priorität zuerst).
+     */
+    std::array<uint8_t, LAYER_COUNT> order = {};
+
+    /**
+     * @brief Letztes Ergebnis je Kanal.
+     */
+    std::array<uint16_t, CHANNELS> result = {};
+
+    /**
+     * @brief Kehrwert von maxLevel als Q24 (für MULTIPLY ohne Division).
+     */
+    uint32_t invMaxQ24;
+
+    /**
+     * @brief Kanäle mit geänderten Ebenen.
+     */
+    uint8_t dirty = 0;
+};
+
+#endif // LIGHT_COMPOSITOR_H
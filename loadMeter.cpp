@@ -0,0 +1,78 @@
+/**
+ * @file loadMeter.cpp
+ * @brief Implementierung der CPU-Lastmessung.
+ *
+ * @author Knut Welzel <knut.welzel@gmail.com>
+ * @date 2025-09-13
+ * @copyright MIT
+ */
+
+#include "loadMeter.h"
+
+// Statische Messwerte
+uint64_t LoadMeter::windowStartUs = 0;
+uint32_t LoadMeter::lastLoopUs = 0;
+uint32_t LoadMeter::idleStartUs = 0;
+uint32_t LoadMeter::idleStartIrqUs = 0;
+std::atomic<uint32_t> LoadMeter::irqUs {0};
+uint32_t LoadMeter::irqFoldedUs = 0;
+LoadMeter::Stats LoadMeter::stats = {};
+
+// Schleifenbeginn: Periode seit dem letzten Durchlauf in das log2-Histogramm einsortieren
+void LoadMeter::loopStart() {
+    uint32_t now = time_us_32();
+    if (stats.loops++) {
+        uint32_t period = now - lastLoopUs;
+        size_t bits = period ? static_cast<size_t>(32 - __builtin_clz(period)) : 0;
+        ++stats.loopPeriodHist[bits < PERIOD_BUCKETS ? bits : PERIOD_BUCKETS - 1];
+        if (period > stats.maxLoopUs) stats.maxLoopUs = period;
+    }
+    lastLoopUs = now;
+}
+
+// Beginn der Schlafphase: Zeit und bisherige IRQ-Zeit merken
+void LoadMeter::idleBegin() {
+    idleStartIrqUs = irqUs.load(std::memory_order_relaxed);
+    idleStartUs = time_us_32();
+}
+
+// Ende der Schlafphase: IRQ-Zeit während des Schlafens zählt als Last
+void LoadMeter::idleEnd() {
+    uint32_t slept = time_us_32() - idleStartUs;
+    uint32_t irq = irqUs.load(std::memory_order_relaxed) - idleStartIrqUs;
+    stats.idleUs += slept > irq ? slept - irq : 0;
+    foldIrq();
+}
+
+// IRQ-Zeit seit der letzten Übertragung addieren (Differenz ist auch über den 32-Bit-Überlauf korrekt)
+void LoadMeter::foldIrq() {
+    uint32_t now = irqUs.load(std::memory_order_relaxed);
+    stats.bucketUs[static_cast<size_t>(Bucket::IRQ)] += now - irqFoldedUs;
+    irqFoldedUs = now;
+}
+
+// Rechenzeit eines Teilsystems addieren (IRQ: nur Laden/Speichern, kein atomares Read-Modify-Write nötig)
+void LoadMeter::add(Bucket bucket, uint32_t us) {
+    if (bucket == Bucket::IRQ) {
+        irqUs.store(irqUs.load(std::memory_order_relaxed) + us, std::memory_order_relaxed);
+        return;
+    }
+    stats.bucketUs[static_cast<size_t>(bucket)] += us;
+}
+
+// Messwerte inkl. Last in Promille
+LoadMeter::Stats LoadMeter::getStats() {
+    foldIrq();
+    Stats out = stats;
+    out.windowUs = time_us_64() - windowStartUs;
+    uint64_t busy = out.windowUs > out.idleUs ? out.windowUs - out.idleUs : 0;
+    out.loadPermille = out.windowUs ? static_cast<uint16_t>((busy * 1000u) / out.windowUs) : 0;
+    return out;
+}
+
+// Neuer Messzeitraum
+void LoadMeter::reset() {
+    stats = {};
+    irqFoldedUs = irqUs.load(std::memory_order_relaxed);
+    windowStartUs = time_us_64();
+}
@@ -0,0 +1,175 @@
+/**
+ * @file loadMeter.h
+ * @brief CPU-Lastmessung und Histogramm der Schleifenperiode (Header).
+ *
+ * Die Hauptschleife meldet jeden Schleifenbeginn (loopStart) und jede Schlafphase (idleBegin/idleEnd
+ * um WFE). Daraus ergeben sich Leerlaufanteil, CPU-Last und ein log2-Histogramm der Schleifenperiode.
+ * Zusätzlich wird die Rechenzeit je Teilsystem (IRQ, Sensorauswertung, Rendering, Logging, USB)
+ * über Scope-Objekte aufsummiert.
+ *
+ * Pro Messpunkt fallen ein time_us_32()-Aufruf und wenige Ganzzahloperationen an; die Messung ist
+ * für den Dauerbetrieb ausgelegt. Einzelne Dauern werden mit 32 Bit gemessen, die Summen (Messzeitraum,
+ * Leerlauf, Teilsysteme) mit 64 Bit über time_us_64(), damit sie nicht nach ca. 71 min überlaufen.
+ * Divisionen erfolgen nur beim Abruf in getStats().
+ *
+ * \par IRQ-Zeit
+ * Die IRQ-Zeit wird im IRQ-Kontext gemessen und zählt immer als Last: Läuft ein IRQ während einer
+ * Schlafphase, wird seine Dauer von der Leerlaufzeit abgezogen. Läuft er während eines anderen
+ * Teilsystems, ist er zusätzlich in dessen Zeit enthalten.
+ *
+ * Erfasst werden die GPIO-Interrupts der Sensoren, der Frame-Timer (FrameRenderer), der Muster-Timer
+ * der Onboard-LED (StatusLed) und der DMA-Interrupt des UART-Logs (LogSink). Nicht erfasst werden die
+ * Interrupts des USB-Stacks (TinyUSB, stdio_usb) und der Verteiler des SDK-Alarm-Interrupts vor und
+ * nach den Timer-Callbacks; ihre Zeit zählt als Leerlauf bzw. zum unterbrochenen Teilsystem.
+ *
+ * \author Knut Welzel <knut.welzel@gmail.com>
+ * \date 2025-09-13
+ * \copyright MIT
+ */
+
+#ifndef LOAD_METER_H
+#define LOAD_METER_H
+
+#include <cstdint>          // Für uint32_t, uint64_t
+#include <cstddef>          // Für size_t
+#include <array>            // Für std::array
+#include <atomic>           // Für std::atomic
+#include "pico/time.h"      // Für time_us_32(), time_us_64()
+
+/**
+ * @class LoadMeter
+ * @brief Statische Lastmessung (eine Hauptschleife, eine Instanz der Messwerte).
+ *
+ * \note Alle Methoden außer Scope mit Bucket::IRQ dürfen nur aus der Hauptschleife aufgerufen werden.
+ */
+class LoadMeter {
+
+public:
+    /**
+     * @brief Teilsysteme, deren Rechenzeit erfasst wird.
+     */
+    enum class Bucket : uint8_t {
+        IRQ    = 0,     ///< GPIO-, Timer- und LogSink-DMA-Interrupts (ohne USB-Stack)
+        SENSOR = 1,     ///< Sensorauswertung, Entprellung, Auslöser, Matrix
+        RENDER = 2,     ///< Fading, Animationen, Ausgabestufe
+        LOG    = 3,     ///< Formatierung von Logmeldungen (nur aus der Hauptschleife, IRQ-Logs zählen unter IRQ)
+        USB    = 4,     ///< Ausgabe der Logmeldungen über stdio (USB-CDC bzw. Kopieren in den UART-Ringpuffer)
+        COUNT  = 5      ///< Anzahl der Teilsysteme
+    };
+
+    /**
+     * @brief Anzahl der Teilsysteme.
+     */
+    static constexpr size_t BUCKET_COUNT = static_cast<size_t>(Bucket::COUNT);
+
+    /**
+     * @brief Klassen des Periodenhistogramms: Klasse k = 2^(k-1)..2^k-1 µs, letzte Klasse ab ca. 0,5 s.
+     */
+    static constexpr size_t PERIOD_BUCKETS = 21;
+
+    /**
+     * @brief Messwerte seit dem letzten reset().
+     */
+    struct Stats {
+        uint64_t windowUs;      ///< Messzeitraum (µs)
+        uint64_t idleUs;        ///< Davon im Leerlauf (WFE, ohne IRQ-Zeit)
+        uint16_t loadPermille;  ///< CPU-Last in Promille
+        uint32_t loops;         ///< Anzahl der Schleifendurchläufe
+        uint32_t maxLoopUs;     ///< Längste Schleifenperiode (µs)
+        std::array<uint64_t, BUCKET_COUNT> bucketUs;            ///< Rechenzeit je Teilsystem (µs)
+        std::array<uint32_t, PERIOD_BUCKETS> loopPeriodHist;    ///< Schleifenperiode, log2-Klassen in µs
+    };
+
+    /**
+     * @brief Misst die Rechenzeit eines Teilsystems für die Lebensdauer des Objekts.
+     */
+    class Scope {
+    public:
+        explicit Scope(Bucket bucket) : bucket(bucket), startUs(time_us_32()) {}
+        ~Scope() { LoadMeter::add(bucket, time_us_32() - startUs); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        Bucket bucket;
+        uint32_t startUs;
+    };
+
+    /**
+     * @brief Meldet den Beginn eines Schleifendurchlaufs (Schleifenperiode für das Histogramm).
+     */
+    static void loopStart();
+
+    /**
+     * @brief Meldet den Beginn einer Schlafphase (unmittelbar vor WFE/sleep).
+     */
+    static void idleBegin();
+
+    /**
+     * @brief Meldet das Ende einer Schlafphase (unmittelbar nach WFE/sleep).
+     */
+    static void idleEnd();
+
+    /**
+     * @brief Addiert Rechenzeit zu einem Teilsystem.
+     *
+     * @param bucket Teilsystem
+     * @param us     Dauer in µs
+     *
+     * @details Bucket::IRQ darf nur aus dem IRQ-Kontext, alle anderen nur aus der Hauptschleife verwendet werden.
+     */
+    static void add(Bucket bucket, uint32_t us);
+
+    /**
+     * @brief Gibt die Messwerte seit dem letzten reset() zurück (inkl. berechneter Last).
+     */
+    static Stats getStats();
+
+    /**
+     * @brief Setzt alle Messwerte zurück und startet einen neuen Messzeitraum.
+     */
+    static void reset();
+
+private:
+    /**
+     * @brief Beginn des Messzeitraums (time_us_64()).
+     */
+    static uint64_t windowStartUs;
+
+    /**
+     * @brief Beginn des letzten Schleifendurchlaufs bzw. der laufenden Schlafphase.
+     */
+    static uint32_t lastLoopUs;
+    static uint32_t idleStartUs;
+
+    /**
+     * @brief IRQ-Zeit zu Beginn der laufenden Schlafphase.
+     */
+    static uint32_t idleStartIrqUs;
+
+    /**
+     * @brief Aufsummierte IRQ-Zeit (einziger Schreiber: IRQ-Kontext).
+     *
+     * 32 Bit, weil 64-Bit-Atomics auf dem Cortex-M0+ nicht sperrfrei sind; die Hauptschleife
+     * überträgt die Differenz regelmäßig in stats.bucketUs (foldIrq()).
+     *
+     * @threadsafe
+     */
+    static std::atomic<uint32_t> irqUs;
+
+    /**
+     * @brief Stand von irqUs bei der letzten Übertragung in stats.bucketUs.
+     */
+    static uint32_t irqFoldedUs;
+
+    /**
+     * @brief Überträgt die seit dem letzten Aufruf angefallene IRQ-Zeit in die 64-Bit-Summe.
+     */
+    static void foldIrq();
+
+    /**
+     * @brief Übrige Messwerte (nur Hauptschleife).
+     */
+    static Stats stats;
+};
+
+#endif // LOAD_METER_H
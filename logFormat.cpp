@@ -0,0 +1,169 @@
+/**
+ * @file logFormat.cpp
+ * @brief Implementierung des Ganzzahl-Formatierers.
+ *
+ * @author Knut Welzel <knut.welzel@gmail.com>
+ * @date 2025-09-13
+ * @copyright MIT
+ */
+
+#include "logFormat.h"
+
+#ifdef CABINET_LOG_BENCHMARK
+#include <cstdio>
+#include <cstdint>
+#include "hardware/structs/systick.h"   // Für den Zyklenzähler
+#include "cabinetLight.h"               // Für die Logging-API
+#endif
+
+// Formatiert mit variabler Argumentliste
+size_t LogFormat::format(char* buf, size_t size, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    size_t len = vformat(buf, size, fmt, args);
+    va_end(args);
+    return len;
+}
+
+// Formatstring zeichenweise abarbeiten; nur Stackvariablen, daher reentrant
+size_t LogFormat::vformat(char* buf, size_t size, const char* fmt, va_list args) {
+    if (!buf || size == 0) return 0;
+    Output out {buf, buf + size - 1};
+
+    while (*fmt) {
+        if (*fmt != '%') {
+            out.put(*fmt++);
+            continue;
+        }
+        const char* spec = fmt++;
+
+        // Flags und Feldbreite
+        bool left = false, zero = false;
+        for (;; ++fmt) {
+            if (*fmt == '-') left = true;
+            else if (*fmt == '0') zero = true;
+            else break;
+        }
+        int width = 0;
+        while (*fmt >= '0' && *fmt <= '9') width = width * 10 + (*fmt++ - '0');
+        bool isLong = false;
+        while (*fmt == 'l' || *fmt == 'h') isLong |= (*fmt++ == 'l');
+
+        switch (*fmt) {
+            case 'd':
+            case 'i': {
+                long v = isLong ? va_arg(args, long) : va_arg(args, int);
+                unsigned long mag = v < 0 ? 0ul - static_cast<unsigned long>(v) : static_cast<unsigned long>(v);
+                putNumber(out, mag, v < 0, 10, false, width, zero, left);
+                break;
+            }
+            case 'u':
+            case 'x':
+            case 'X': {
+                unsigned long v = isLong ? va_arg(args, unsigned long) : va_arg(args, unsigned);
+                putNumber(out, v, false, *fmt == 'u' ? 10 : 16, *fmt == 'X', width, zero, left);
+                break;
+            }
+            case 's':
+                putString(out, va_arg(args, const char*), width, left);
+                break;
+            case 'c': {
+                char c[2] = {static_cast<char>(va_arg(args, int)), '\0'};
+                putString(out, c, width, left);
+                break;
+            }
+            case '%':
+                out.put('%');
+                break;
+            default:
+                // Nicht unterstützt: Spezifikation unverändert ausgeben
+                while (spec < fmt) out.put(*spec++);
+                if (!*fmt) continue;
+                out.put(*fmt);
+                break;
+        }
+        ++fmt;
+    }
+    *out.pos = '\0';
+    return static_cast<size_t>(out.pos - buf);
+}
+
+// Zeichenkette mit Auffüllung auf die Feldbreite
+void LogFormat::putString(Output& out, const char* s, int width, bool left) {
+    if (!s) s = "(null)";
+    int len = 0;
+    while (s[len]) ++len;
+    if (!left) out.pad(' ', width - len);
+    while (*s) out.put(*s++);
+    if (left) out.pad(' ', width - len);
+}
+
+// Ziffern rückwärts in einen Stackpuffer, danach Vorzeichen, Auffüllung und Ziffern ausgeben
+void LogFormat::putNumber(Output& out, unsigned long value, bool negative, unsigned base,
+                          bool upper, int width, bool zero, bool left) {
+    const char* digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    char tmp[3 * sizeof(unsigned long)];
+    int n = 0;
+    do {
+        tmp[n++] = digits[value % base];
+        value /= base;
+    } while (value);
+
+    int padding = width - n - (negative ? 1 : 0);
+    if (!left && !zero) out.pad(' ', padding);
+    if (negative) out.put('-');
+    if (!left && zero) out.pad('0', padding);
+    while (n) out.put(tmp[--n]);
+    if (left) out.pad(' ', padding);
+}
+
+#ifdef CABINET_LOG_BENCHMARK
+namespace {
+
+// Zyklenzähler: SysTick mit Prozessortakt, 24 Bit abwärts zählend
+inline uint32_t cycles() { return systick_hw->cvr; }
+
+// Einheitliche Signatur für beide Formatierer
+using Formatter = size_t (*)(char*, size_t, const char*, va_list);
+
+size_t viaVsnprintf(char* buf, size_t size, const char* fmt, va_list args) {
+    int len = vsnprintf(buf, size, fmt, args);
+    return len < 0 ? 0 : static_cast<size_t>(len);
+}
+
+uint32_t measure(Formatter f, char* buf, size_t size, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    uint32_t start = cycles();
+    f(buf, size, fmt, args);
+    uint32_t elapsed = (start - cycles()) & 0x00FFFFFFu;
+    va_end(args);
+    return elapsed;
+}
+
+} // namespace
+
+// Typische Logzeilen je 100-mal formatieren, Mittelwert der Zyklen pro Aufruf ausgeben
+void LogFormat::benchmark() {
+    static constexpr int ROUNDS = 100;
+    systick_hw->rvr = 0x00FFFFFFu;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5;  // Aktiv, Prozessortakt, kein Interrupt
+
+    char line[160];
+    uint32_t sum[2][3] = {};
+    const Formatter formatters[2] = {&LogFormat::vformat, &viaVsnprintf};
+    for (int f = 0; f < 2; ++f) {
+        for (int i = 0; i < ROUNDS; ++i) {
+            sum[f][0] += measure(formatters[f], line, sizeof(line), "Kanal %d: Tür geöffnet\n", i & 3);
+            sum[f][1] += measure(formatters[f], line, sizeof(line), "gpioCallback: GPIO %d, events=0x%08x\n", 14, 0x8u);
+            sum[f][2] += measure(formatters[f], line, sizeof(line), "process: channel %d sensors=0x%02x -> fade %s\n",
+                                 2, 0x5u, "on");
+        }
+    }
+    for (int k = 0; k < 3; ++k) {
+        CabinetLight::logInfo("Log-Benchmark Zeile %d: LogFormat %u Zyklen, vsnprintf %u Zyklen\n", k,
+                              static_cast<unsigned>(sum[0][k] / ROUNDS), static_cast<unsigned>(sum[1][k] / ROUNDS));
+    }
+}
+#endif
@@ -0,0 +1,83 @@
+/**
+ * @file logFormat.h
+ * @brief Kleiner, reentranter Ganzzahl-Formatierer für die Logging-API (Header).
+ *
+ * Ersetzt vsnprintf() in den Log-Funktionen. Unterstützt wird nur die Teilmenge, die die Logstellen
+ * der Firmware verwenden:
+ * - Umwandlungen: %d, %i, %u, %x, %X, %s, %c, %%
+ * - Flags: '-' (linksbündig), '0' (führende Nullen), Feldbreite (z.B. %08x)
+ * - Längenmodifikator 'l' (auf dem RP2040 gleich breit wie int)
+ *
+ * Keine Gleitkommazahlen, kein Heap, kein globaler Zustand: Die Funktionen sind aus Hauptschleife,
+ * IRQ und beiden Kernen gleichzeitig aufrufbar. Unbekannte Umwandlungen werden unverändert ausgegeben.
+ *
+ * \par Vergleich mit vsnprintf
+ * Mit der CMake-Option CABINET_LOG_BENCHMARK misst LogFormat::benchmark() die Zyklen pro Aufruf
+ * (SysTick) für typische Logzeilen gegen vsnprintf(). Die Codegröße zeigt `make footprint`.
+ *
+ * \author Knut Welzel <knut.welzel@gmail.com>
+ * \date 2025-09-13
+ * \copyright MIT
+ */
+
+#ifndef LOG_FORMAT_H
+#define LOG_FORMAT_H
+
+#include <cstddef>          // Für size_t
+#include <cstdarg>          // Für va_list
+
+/**
+ * @class LogFormat
+ * @brief Statischer printf-Ersatz für Ganzzahlen und Zeichenketten.
+ */
+class LogFormat {
+
+public:
+    /**
+     * @brief Formatiert in einen Puffer des Aufrufers.
+     *
+     * @param buf  Zielpuffer (wird immer nullterminiert, sofern size > 0)
+     * @param size Größe des Zielpuffers in Byte
+     * @param fmt  Formatstring (Teilmenge von printf, siehe Dateikopf)
+     * @param ...  Argumente
+     * @return Anzahl der geschriebenen Zeichen ohne Nullterminierung (bei Kürzung size - 1)
+     */
+    static size_t format(char* buf, size_t size, const char* fmt, ...);
+
+    /**
+     * @brief Wie format(), mit va_list.
+     */
+    static size_t vformat(char* buf, size_t size, const char* fmt, va_list args);
+
+#ifdef CABINET_LOG_BENCHMARK
+    /**
+     * @brief Misst die Zyklen pro Aufruf von vformat() und vsnprintf() für typische Logzeilen
+     *        und gibt das Ergebnis über die Logging-API aus.
+     */
+    static void benchmark();
+#endif
+
+private:
+    /**
+     * @brief Schreibposition mit Obergrenze (ein Byte für die Nullterminierung ist reserviert).
+     */
+    struct Output {
+        char* pos;
+        char* end;
+        void put(char c) { if (pos < end) *pos++ = c; }
+        void pad(char c, int count) { while (count-- > 0) put(c); }
+    };
+
+    /**
+     * @brief Gibt eine Zeichenkette mit Feldbreite aus.
+     */
+    static void putString(Output& out, const char* s, int width, bool left);
+
+    /**
+     * @brief Gibt eine Zahl (Basis 10 oder 16) mit Vorzeichen, Feldbreite und Auffüllung aus.
+     */
+    static void putNumber(Output& out, unsigned long value, bool negative, unsigned base,
+                          bool upper, int width, bool zero, bool left);
+};
+
+#endif // LOG_FORMAT_H
@@ -0,0 +1,38 @@
+/**
+ * @file logRateLimiter.cpp
+ * @brief Implementierung der Token-Bucket-Ratenbegrenzung.
+ *
+ * @author Knut Welzel <knut.welzel@gmail.com>
+ * @date 2025-09-13
+ * @copyright MIT
+ */
+
+#include "logRateLimiter.h"
+#include "pico/time.h"      // Für time_us_64()
+
+// Token nach verstrichener Zeit auffüllen (ganze Intervalle), dann eines verbrauchen oder unterdrücken
+bool LogRateLimiter::allow(uint32_t& suppressed) {
+    uint64_t now = time_us_64();
+    if (!started) {
+        started = true;
+        lastRefillUs = now;
+    }
+    if (tokens < BURST) {
+        uint64_t refill = (now - lastRefillUs) / REFILL_US;
+        if (refill) {
+            tokens = (refill >= BURST - tokens) ? BURST : tokens + static_cast<uint32_t>(refill);
+            lastRefillUs += refill * REFILL_US;
+        }
+    } else {
+        lastRefillUs = now;
+    }
+
+    if (!tokens) {
+        ++suppressedCount;
+        return false;
+    }
+    --tokens;
+    suppressed = suppressedCount;
+    suppressedCount = 0;
+    return true;
+}
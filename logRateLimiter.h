@@ -0,0 +1,61 @@
+/**
+ * @file logRateLimiter.h
+ * @brief Token-Bucket-Ratenbegrenzung für einzelne Logstellen (Header).
+ *
+ * Jede Logstelle der LOG_*-Makros (siehe cabinetLight.h) besitzt ein eigenes statisches
+ * LogRateLimiter-Objekt. Ein Eimer fasst BURST Token und wird alle REFILL_US µs um ein Token
+ * aufgefüllt. Jede Meldung verbraucht ein Token; ohne Token wird sie unterdrückt und gezählt.
+ * Die Anzahl unterdrückter Meldungen wird mit der nächsten durchgelassenen Meldung derselben
+ * Stelle als "N messages suppressed" ausgegeben.
+ *
+ * Der Konstruktor ist constexpr, die statischen Objekte werden daher ohne Initialisierungswächter
+ * angelegt und sind auch in IRQ-Handlern verwendbar.
+ *
+ * \author Knut Welzel <knut.welzel@gmail.com>
+ * \date 2025-09-13
+ * \copyright MIT
+ */
+
+#ifndef LOG_RATE_LIMITER_H
+#define LOG_RATE_LIMITER_H
+
+#include <cstdint>          // Für uint32_t
+
+/**
+ * @class LogRateLimiter
+ * @brief Token-Bucket für eine Logstelle.
+ *
+ * \note Ein Objekt darf nur aus einem Kontext (Hauptschleife oder ein IRQ) verwendet werden.
+ */
+class LogRateLimiter {
+
+public:
+    /**
+     * @brief Maximale Anzahl Meldungen in einem Schub.
+     */
+    static constexpr uint32_t BURST = 5;
+
+    /**
+     * @brief Abstand, in dem ein Token nachgefüllt wird (µs); 100 ms = 10 Meldungen/s im Dauerbetrieb.
+     */
+    static constexpr uint32_t REFILL_US = 100000;
+
+    constexpr LogRateLimiter() = default;
+
+    /**
+     * @brief Prüft, ob eine Meldung ausgegeben werden darf, und verbraucht ggf. ein Token.
+     *
+     * @param suppressed Ausgabe: Anzahl der seit der letzten ausgegebenen Meldung unterdrückten
+     *                   Meldungen (nur gültig bei Rückgabewert true, danach zurückgesetzt)
+     * @return true, wenn die Meldung ausgegeben werden darf
+     */
+    bool allow(uint32_t& suppressed);
+
+private:
+    uint32_t tokens = BURST;        ///< Verfügbare Token
+    uint64_t lastRefillUs = 0;      ///< Zeitpunkt der letzten Auffüllung (time_us_64(), kein Überlauf nach 71 min)
+    uint32_t suppressedCount = 0;   ///< Unterdrückte Meldungen seit der letzten Ausgabe
+    bool started = false;           ///< Erste Verwendung (lastRefillUs noch nicht gesetzt)
+};
+
+#endif // LOG_RATE_LIMITER_H
@@ -0,0 +1,125 @@
+/**
+ * @file logSink.cpp
+ * @brief Implementierung der UART-DMA-Logausgabe.
+ *
+ * @author Knut Welzel <knut.welzel@gmail.com>
+ * @date 2025-09-13
+ * @copyright MIT
+ */
+
+#include "logSink.h"
+#include "pico/stdio.h"         // Für stdio_driver_t
+#include "pico/stdio/driver.h"  // Für die Felder des stdio-Treibers
+#include "hardware/uart.h"      // Für UART0
+#include "hardware/dma.h"       // Für den DMA-Kanal
+#include "hardware/irq.h"       // Für den DMA-Interrupt
+#include "hardware/sync.h"      // Für den Spinlock
+#include "hardware/gpio.h"      // Für die Pinfunktion
+#include "loadMeter.h"          // Für die IRQ-Zeitmessung
+
+// Statischer Zustand
+char LogSink::buffer[BUFFER_SIZE];
+volatile uint32_t LogSink::head = 0;
+volatile uint32_t LogSink::tail = 0;
+volatile uint32_t LogSink::inFlight = 0;
+std::atomic<uint32_t> LogSink::droppedBytes {0};
+int LogSink::dmaChannel = -1;
+int LogSink::spinLockNum = -1;
+
+// stdio-Treiber (Felder werden in init() gesetzt)
+static stdio_driver_t uartDmaDriver;
+
+// UART, DMA (8 Bit, Lesen inkrementierend, Takt über DREQ des UART-Sendefifos) und stdio-Treiber einrichten
+bool LogSink::init() {
+    if (dmaChannel >= 0) return true;
+    int channel = dma_claim_unused_channel(false);
+    int lockNum = spin_lock_claim_unused(false);
+    if (channel < 0 || lockNum < 0) {
+        if (channel >= 0) dma_channel_unclaim(channel);
+        if (lockNum >= 0) spin_lock_unclaim(lockNum);
+        return false;
+    }
+    dmaChannel = channel;
+    spinLockNum = lockNum;
+
+    uart_init(uart0, BAUD_RATE);
+    gpio_set_function(TX_PIN, GPIO_FUNC_UART);
+    uart_set_fifo_enabled(uart0, true);
+
+    dma_channel_config cfg = dma_channel_get_default_config(dmaChannel);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_8);
+    channel_config_set_read_increment(&cfg, true);
+    channel_config_set_write_increment(&cfg, false);
+    channel_config_set_dreq(&cfg, uart_get_dreq(uart0, true));
+    dma_channel_configure(dmaChannel, &cfg, &uart_get_hw(uart0)->dr, buffer, 0, false);
+
+    dma_channel_set_irq1_enabled(dmaChannel, true);
+    irq_add_shared_handler(DMA_IRQ_1, dmaIrqHandler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+
+    uartDmaDriver.out_chars = stdioOutChars;
+    uartDmaDriver.out_flush = stdioOutFlush;
+#if PICO_STDIO_ENABLE_CRLF_SUPPORT
+    stdio_set_translate_crlf(&uartDmaDriver, PICO_STDIO_DEFAULT_CRLF);
+#endif
+    stdio_set_driver_enabled(&uartDmaDriver, true);
+    return true;
+}
+
+// Ganze Ausgabe übernehmen oder verwerfen; der Spinlock wird nur für das Kopieren gehalten
+bool LogSink::write(const char* data, size_t len) {
+    if (dmaChannel < 0 || len == 0) return len == 0;
+    spin_lock_t* lock = spin_lock_instance(spinLockNum);
+    uint32_t saved = spin_lock_blocking(lock);
+    uint32_t used = head - tail;
+    if (len > BUFFER_SIZE - used) {
+        spin_unlock(lock, saved);
+        droppedBytes.fetch_add(static_cast<uint32_t>(len), std::memory_order_relaxed);
+        return false;
+    }
+    uint32_t pos = head;
+    for (size_t i = 0; i < len; ++i) buffer[(pos + i) & (BUFFER_SIZE - 1)] = data[i];
+    head = pos + static_cast<uint32_t>(len);
+    if (!inFlight) startTransfer();
+    spin_unlock(lock, saved);
+    return true;
+}
+
+// Nächsten zusammenhängenden Abschnitt (bis head bzw. bis zum Pufferende) an den DMA übergeben
+void LogSink::startTransfer() {
+    uint32_t pending = head - tail;
+    if (!pending) return;
+    uint32_t offset = tail & (BUFFER_SIZE - 1);
+    uint32_t chunk = BUFFER_SIZE - offset;
+    if (chunk > pending) chunk = pending;
+    inFlight = chunk;
+    dma_channel_transfer_from_buffer_now(dmaChannel, &buffer[offset], chunk);
+}
+
+// Abschnitt fertig: Platz freigeben und ggf. den nächsten starten
+void LogSink::dmaIrqHandler() {
+    if (!dma_channel_get_irq1_status(dmaChannel)) return;
+    LoadMeter::Scope load(LoadMeter::Bucket::IRQ);
+    dma_channel_acknowledge_irq1(dmaChannel);
+    spin_lock_t* lock = spin_lock_instance(spinLockNum);
+    uint32_t saved = spin_lock_blocking(lock);
+    tail += inFlight;
+    inFlight = 0;
+    startTransfer();
+    spin_unlock(lock, saved);
+}
+
+// Warten, bis alle Abschnitte übertragen sind und das Sendefifo leer ist
+void LogSink::flush() {
+    if (dmaChannel < 0) return;
+    while (head != tail) tight_loop_contents();
+    uart_tx_wait_blocking(uart0);
+}
+
+void LogSink::stdioOutChars(const char* buf, int len) {
+    if (len > 0) write(buf, static_cast<size_t>(len));
+}
+
+void LogSink::stdioOutFlush() {
+    flush();
+}
@@ -0,0 +1,130 @@
+/**
+ * @file logSink.h
+ * @brief Nicht blockierende Logausgabe über UART mit DMA aus einem Ringpuffer (Header).
+ *
+ * Alternative zur Ausgabe über USB-CDC: LogSink meldet sich als stdio-Treiber des Pico-SDK an,
+ * sodass printf(), stdio_put_string() und damit die gesamte Logging-API unverändert auf den UART
+ * schreiben. Die Zeichen werden nur in einen RAM-Ringpuffer kopiert; ein DMA-Kanal überträgt den
+ * belegten Bereich selbstständig in das UART-Sendefifo und startet aus seinem Interrupt den nächsten
+ * Abschnitt.
+ *
+ * \par Nicht blockierend
+ * Ist im Ringpuffer nicht genug Platz für eine Ausgabe, wird sie vollständig verworfen (keine halben
+ * Zeilen) und die Anzahl der verworfenen Byte gezählt. Schreiben ist aus Hauptschleife, IRQ und
+ * beiden Kernen möglich (kurzer Abschnitt unter einem Hardware-Spinlock).
+ *
+ * \par Auswahl
+ * CMake-Cachevariable CABINET_LOG_SINK=UART: Diese Datei wird übersetzt, CABINET_LOG_SINK_UART ist
+ * definiert und der USB-Stack (pico_stdio_usb, TinyUSB) entfällt vollständig. Standard ist USB.
+ *
+ * \author Knut Welzel <knut.welzel@gmail.com>
+ * \date 2025-09-13
+ * \copyright MIT
+ */
+
+#ifndef LOG_SINK_H
+#define LOG_SINK_H
+
+#include <cstdint>          // Für uint32_t
+#include <cstddef>          // Für size_t
+#include <atomic>           // Für std::atomic
+
+/**
+ * @class LogSink
+ * @brief Statischer stdio-Treiber: UART0 mit DMA-Sendung aus einem Ringpuffer.
+ */
+class LogSink {
+
+public:
+    /**
+     * @brief Baudrate des Log-UART.
+     */
+    static constexpr uint32_t BAUD_RATE = 921600;
+
+    /**
+     * @brief Sendepin (UART0 TX).
+     */
+    static constexpr uint8_t TX_PIN = 0;
+
+    /**
+     * @brief Größe des Ringpuffers in Byte (Zweierpotenz).
+     */
+    static constexpr size_t BUFFER_SIZE = 4096;
+
+    static_assert((BUFFER_SIZE & (BUFFER_SIZE - 1)) == 0, "BUFFER_SIZE muss eine Zweierpotenz sein");
+
+    /**
+     * @brief Initialisiert UART, DMA-Kanal und Spinlock und meldet den stdio-Treiber an.
+     *
+     * @return true bei Erfolg, false wenn kein DMA-Kanal oder Spinlock frei ist
+     */
+    static bool init();
+
+    /**
+     * @brief Kopiert Zeichen in den Ringpuffer und startet bei Bedarf die DMA-Übertragung.
+     *
+     * @param data Zeichen
+     * @param len  Anzahl
+     * @return true, wenn die Zeichen übernommen wurden, false wenn sie verworfen wurden
+     *
+     * @details Blockiert nie; bei zu wenig Platz wird die gesamte Ausgabe verworfen.
+     */
+    static bool write(const char* data, size_t len);
+
+    /**
+     * @brief Wartet, bis der Ringpuffer geleert und das letzte Zeichen gesendet ist.
+     *
+     * @details Blockierend – nur für Massenausgaben außerhalb des Echtzeitpfads (z.B. Trace::dump()
+     *          über stdio_flush(); fflush(stdout) erreicht den Treiber nicht).
+     */
+    static void flush();
+
+    /**
+     * @brief Anzahl der seit dem Start verworfenen Byte.
+     */
+    static uint32_t getDroppedBytes() { return droppedBytes.load(std::memory_order_relaxed); }
+
+private:
+    /**
+     * @brief Startet die Übertragung des nächsten zusammenhängenden Abschnitts (Spinlock gehalten).
+     */
+    static void startTransfer();
+
+    /**
+     * @brief DMA-Interrupt: gesendeten Abschnitt freigeben und nächsten starten.
+     */
+    static void dmaIrqHandler();
+
+    /**
+     * @brief Einsprungpunkte des stdio-Treibers.
+     */
+    static void stdioOutChars(const char* buf, int len);
+    static void stdioOutFlush();
+
+    /**
+     * @brief Ringpuffer; head (Schreiber) und tail (DMA) zählen fortlaufend, Index = Wert % BUFFER_SIZE.
+     */
+    static char buffer[BUFFER_SIZE];
+    static volatile uint32_t head;
+    static volatile uint32_t tail;
+
+    /**
+     * @brief Länge des laufenden DMA-Abschnitts (0 = DMA untätig).
+     */
+    static volatile uint32_t inFlight;
+
+    /**
+     * @brief Verworfene Byte.
+     *
+     * @threadsafe
+     */
+    static std::atomic<uint32_t> droppedBytes;
+
+    /**
+     * @brief DMA-Kanal und Spinlock-Nummer (-1 = nicht initialisiert).
+     */
+    static int dmaChannel;
+    static int spinLockNum;
+};
+
+#endif // LOG_SINK_H
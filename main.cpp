@@ -14,9 +14,11 @@
  * - PWM-Dimmung für sanftes Ein-/Ausschalten (Fading)
  * - IRQ-basiertes Event-Handling (Polling-Fallback optional)
  * - Fehlerbehandlung mit LED-Signalisierung
- * - Heartbeat-LED als Lebenszeichen
+ * - Statusanzeige über die Onboard-LED (Heartbeat, Bootstufen, Fehlercodes; Timer-gesteuert)
  * - Startup-Test für alle LED-Kanäle
  * - Umfangreiche Logging-API mit LogLevel
+ * - CPU-Lastmessung (Leerlaufzeit um WFE, Histogramm der Schleifenperiode)
+ * - Stack-High-Water-Mark je Kern (Meldung bei neuem Höchststand)
  *
  * Hardware-Anforderungen:
  * - Raspberry Pi Pico W
@@ -36,72 +38,122 @@
 
 #include "cabinetLight.h"
 #include "hardware/irq.h"
-#include <cstdio>
+#include "stackMonitor.h"
+#include "crashReport.h"
+#include "supervisor.h"
+#include "statusLed.h"
+#ifdef CABINET_LOG_SINK_UART
+#include "logSink.h"
+#endif
 
 /**
  * @brief Hauptfunktion: Initialisiert Hardware und steuert die Schrankbeleuchtung.
  *
  * - Initialisiert USB-CDC für Debug-Ausgaben
- * - Führt einen Boot-Blink auf der Onboard-LED aus
+ * - Startet die Muster-Engine der Onboard-LED und zeigt die Bootstufen an
  * - Aktiviert GPIO-Interrupts für die Sensoren
  * - Erstellt und konfiguriert die CabinetLight-Instanz
  * - Setzt die Sensor-Polarity (active-low)
- * - Führt einen Startup-Test der LEDs aus
- * - Startet die Hauptschleife mit periodischer Event-Verarbeitung und Heartbeat-LED
+ * - Übernimmt den Sensorzustand beim Start (offene Türen leuchten sofort)
+ * - Führt einen Startup-Test der LEDs aus (nur wenn beim Start keine Tür offen ist)
+ * - Startet die ereignisgesteuerte Hauptschleife (WFE bis IRQ, Frame-Tick, Deadline oder Watchdog-Service;
+ *   der Heartbeat atmet per PWM/DMA ohne CPU)
  *
  * @return int Rückgabewert (0 bei Erfolg)
  */
 int main() {
 
-    // 1. USB-CDC initialisieren (ermöglicht printf-Debug-Ausgaben über USB)
+    // 0. Ungenutzten Stack bemalen (Basis der High-Water-Mark-Messung)
+    StackMonitor::paint();
+
+    // 1. stdio initialisieren: USB-CDC oder UART mit DMA (CMake-Cachevariable CABINET_LOG_SINK)
     stdio_init_all();
+#ifdef CABINET_LOG_SINK_UART
+    LogSink::init();
+#else
     sleep_ms(200); // Warten, damit Host Zeit für USB-Enumeration hat
-    printf("[DEBUG] Firmware-Start.\n");
+#endif
+    LOG_DEBUG(INIT, "Firmware-Start.\n");
+
+    // 1b. Absturzbericht des vorherigen Laufs ausgeben (HardFault/Fatal aus dem nicht initialisierten RAM)
+    CrashReport::reportOnBoot();
 
-    // 2. Boot-Blink: Onboard-LED blinkt 3x als Lebenszeichen nach Reset
-    CabinetLight::blinkOnboardLed(3, 150, 150);
+    // 2. Muster-Engine der Onboard-LED starten; bis zur Hauptschleife zeigt sie die aktuelle Bootstufe
+    //    (N schnelle Impulse = Schritt N, jeweils vor dem Schritt gesetzt) – bleibt der Start hängen,
+    //    ist der erreichte Schritt an der LED ablesbar
+    StatusLed::init();
+    StatusLed::setBootStage(2);
 
     // 3. GPIO-Interrupts für Sensoren aktivieren (ermöglicht IRQ-basiertes Event-Handling)
+    StatusLed::setBootStage(3);
     irq_set_enabled(IO_IRQ_BANK0, true);
 
     // 4. CabinetLight-Instanz erzeugen und konfigurieren
     //    - Kapselt alle Logik für Sensoren, LEDs, PWM, Fading, Fehlerbehandlung
+    StatusLed::setBootStage(4);
     static CabinetLight cabinetLightInstance;
     CabinetLight *cabinetLight = &cabinetLightInstance;
     cabinetLight->setPollingFallback(false); // Polling-Fallback deaktiviert (nur IRQ-Betrieb)
 
-    // 5. Initialisierung prüfen: Bei Fehler Endlosschleife mit Fehler-Blink
+    // 5. Initialisierung prüfen: Einzelne defekte Kanäle -> eingeschränkter Betrieb mit Blinkcode,
+    //    nur wenn kein LED-Kanal nutzbar ist: Endlosschleife mit Fehler-Blink
+    StatusLed::setBootStage(5);
     if (!cabinetLight->isInitialized()) {
-        printf("[FATAL] Fehler bei der Initialisierung der CabinetLight-Hardware!\n");
+        LOG_ERROR(INIT, "Fehler bei der Initialisierung der CabinetLight-Hardware!\n");
         CabinetLight::fatalErrorBlink();
     }
 
     // 6. Sensor-Polarity setzen: Alle Sensoren als active-low (Reedkontakt schließt gegen Masse)
+    StatusLed::setBootStage(6);
     cabinetLight->setSensorPolarity({true, true, true, true});
-    printf("[TEST] Sensor polarity set to active-low (true für active-low)\n");
+    LOG_INFO(INIT, "Sensor polarity set to active-low (true für active-low)\n");
+
+    // 7. Startabgleich: bereits offene Türen sofort einblenden (ein gpio_get_all() je Abtastung, Polarity,
+    //    bestätigende Abtastungen); Zeiten bis zum ersten Licht stehen in getBootSyncStats()
+    StatusLed::setBootStage(7);
+    bool doorOpenAtBoot = cabinetLight->syncSensors();
+
+    // 8. Startup-Test: LEDs nacheinander blinken lassen (zeigt Funktion aller Kanäle);
+    //    entfällt, wenn beim Start eine Tür offen ist – das Licht hat dann Vorrang
+    StatusLed::setBootStage(8);
+    if (!doorOpenAtBoot) {
+        cabinetLight->runStartupTest();
+    } else {
+        LOG_INFO(INIT, "Startup-Test übersprungen (Tür beim Start offen)\n");
+    }
 
-    // 7. Startup-Test: LEDs nacheinander blinken lassen (zeigt Funktion aller Kanäle)
-    cabinetLight->runStartupTest();
+#ifdef CABINET_LOG_BENCHMARK
+    // Optional: Log-Formatierer gegen vsnprintf messen (CMake-Option CABINET_LOG_BENCHMARK)
+    LogFormat::benchmark();
+#endif
 
-    // 8. Hauptschleife: Event-Verarbeitung und Heartbeat-LED
+    // 9. Hauptschleife: Event-Verarbeitung und periodische Prüfungen
     //    - process(): verarbeitet Sensor- und LED-Events, Fading, IRQs
-    //    - Heartbeat: Onboard-LED blinkt im Sekundentakt als Lebenszeichen
-    absolute_time_t hb_last = get_absolute_time();
-    bool hb_state = false;
+    //    - Heartbeat: Onboard-LED atmet per PWM und DMA (ohne CPU, Interrupt oder Aufwachen);
+    //      die Lebendigkeit der Schleife überwacht allein der Watchdog
+    StatusLed::setBasePattern(StatusLed::Pattern::BREATHE);
+    StatusLed::setBootStage(0);
+    absolute_time_t check_next = make_timeout_time_ms(CabinetLight::HEARTBEAT_INTERVAL_MS);
+    LoadMeter::reset();     // Lastmessung ab Beginn der Hauptschleife
+    Supervisor::start();    // Neustartgrund melden, Watchdog ab hier aktiv
 
-    // Hauptschleife: Verarbeitet Events und steuert Heartbeat
+    // Hauptschleife: Verarbeitet Events und prüft periodisch die Stack-Höchststände
     while (true) {
+        LoadMeter::loopStart();
         // Event-Verarbeitung
         cabinetLight->process();
-        // Heartbeat-LED toggeln (alle 1s)
-        absolute_time_t now = get_absolute_time();
-        // Zeitdifferenz berechnen
-        if (absolute_time_diff_us(hb_last, now) > CabinetLight::HEARTBEAT_INTERVAL_MS * 1000) {
-            hb_last = now;
-            hb_state = !hb_state;
-            // Onboard-LED setzen
-            gpio_put(PICO_DEFAULT_LED_PIN, hb_state);
+        // Watchdog nur füttern, wenn alle Teilsysteme ihre Frist eingehalten haben
+        Supervisor::service();
+        // Periodische Prüfungen (höchstens alle 1s, nur bei ohnehin erfolgtem Aufwachen)
+        if (time_reached(check_next)) {
+            check_next = make_timeout_time_ms(CabinetLight::HEARTBEAT_INTERVAL_MS);
+            // Stack-Höchststände prüfen (Meldung nur bei Zuwachs)
+            StackMonitor::check();
         }
-        sleep_ms(50); // Kurze Pause zur CPU-Entlastung
+        // Schlafen bis zum nächsten Ereignis: GPIO-IRQ, Frame-Tick, nächste Deadline oder Watchdog-Service
+        absolute_time_t wake = absolute_time_min(Supervisor::nextService(), cabinetLight->nextDeadline());
+        LoadMeter::idleBegin();
+        best_effort_wfe_or_timeout(wake);
+        LoadMeter::idleEnd();
     }
 }
\ No newline at end of file
@@ -0,0 +1,71 @@
+/**
+ * @file stackMonitor.cpp
+ * @brief Implementierung der Stack-Füllstandsmessung.
+ *
+ * @author Knut Welzel <knut.welzel@gmail.com>
+ * @date 2025-09-13
+ * @copyright MIT
+ */
+
+#include "stackMonitor.h"
+#include "cabinetLight.h"   // Für die Logging-API
+#include "hardware/sync.h"  // Für save_and_disable_interrupts()
+
+// Stackgrenzen aus dem Linkerskript des Pico-SDK (memmap_default.ld)
+extern "C" {
+    extern uint32_t __StackBottom[];
+    extern uint32_t __StackTop[];
+    extern uint32_t __StackOneBottom[];
+    extern uint32_t __StackOneTop[];
+}
+
+size_t StackMonitor::reported[CORES] = {};
+bool StackMonitor::painted = false;
+
+uint32_t* StackMonitor::bottom(size_t core) {
+    return core == 0 ? __StackBottom : __StackOneBottom;
+}
+
+uint32_t* StackMonitor::top(size_t core) {
+    return core == 0 ? __StackTop : __StackOneTop;
+}
+
+// Stack bemalen: Kern 0 nur unterhalb des aktuellen Rahmens (mit Sicherheitsabstand), Kern 1 vollständig
+// Interrupts sind dabei gesperrt, da ein IRQ-Rahmen sonst im gerade bemalten Bereich liegen könnte
+void StackMonitor::paint() {
+    uint32_t irq = save_and_disable_interrupts();
+    volatile uint32_t marker = 0;
+    uint32_t* limit = reinterpret_cast<uint32_t*>(reinterpret_cast<uintptr_t>(&marker) - PAINT_MARGIN);
+    for (volatile uint32_t* p = bottom(0); p < limit; ++p) *p = PAINT_PATTERN;
+    for (volatile uint32_t* p = bottom(1); p < top(1); ++p) *p = PAINT_PATTERN;
+    painted = true;
+    restore_interrupts(irq);
+}
+
+size_t StackMonitor::sizeBytes(size_t core) {
+    if (core >= CORES) return 0;
+    return static_cast<size_t>(top(core) - bottom(core)) * sizeof(uint32_t);
+}
+
+// High-Water-Mark: erstes Wort von unten, das nicht mehr das Muster enthält
+size_t StackMonitor::usedBytes(size_t core) {
+    if (core >= CORES || !painted) return 0;
+    const volatile uint32_t* p = bottom(core);
+    const uint32_t* end = top(core);
+    while (p < end && *p == PAINT_PATTERN) ++p;
+    return static_cast<size_t>(end - p) * sizeof(uint32_t);
+}
+
+// Neue Höchststände melden
+bool StackMonitor::check() {
+    bool grown = false;
+    for (size_t core = 0; core < CORES; ++core) {
+        size_t used = usedBytes(core);
+        if (used <= reported[core]) continue;
+        reported[core] = used;
+        grown = true;
+        CabinetLight::logInfo("Stack Kern %u: %u von %u Byte genutzt\n", static_cast<unsigned>(core),
+                              static_cast<unsigned>(used), static_cast<unsigned>(sizeBytes(core)));
+    }
+    return grown;
+}
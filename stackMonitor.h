@@ -0,0 +1,93 @@
+/**
+ * @file stackMonitor.h
+ * @brief Stack-Füllstandsmessung (High-Water-Mark) für beide Kerne (Header).
+ *
+ * Beim Start wird der ungenutzte Teil der Stacks mit einem Muster beschrieben ("Stack Painting").
+ * Die High-Water-Mark ergibt sich aus dem tiefsten Wort, das nicht mehr das Muster enthält.
+ * Die Stackgrenzen stammen aus dem Linkerskript des Pico-SDK:
+ * - Kern 0: __StackBottom .. __StackTop (SCRATCH_Y, Standard 2 KB)
+ * - Kern 1: __StackOneBottom .. __StackOneTop (SCRATCH_X, Standard 2 KB)
+ *
+ * Ergänzend erzeugt das Build-Target stack_report eine Übersicht der statischen Stackrahmen
+ * aller Funktionen (-fstack-usage, tools/stack_report.py).
+ *
+ * \author Knut Welzel <knut.welzel@gmail.com>
+ * \date 2025-09-13
+ * \copyright MIT
+ */
+
+#ifndef STACK_MONITOR_H
+#define STACK_MONITOR_H
+
+#include <cstdint>          // Für uint32_t
+#include <cstddef>          // Für size_t
+
+/**
+ * @class StackMonitor
+ * @brief Statische Stack-Überwachung beider Kerne.
+ *
+ * \note paint() muss einmal früh in main() aufgerufen werden, bevor Kern 1 gestartet wird.
+ */
+class StackMonitor {
+
+public:
+    /**
+     * @brief Anzahl der Kerne.
+     */
+    static constexpr size_t CORES = 2;
+
+    /**
+     * @brief Füllmuster für ungenutzten Stack.
+     */
+    static constexpr uint32_t PAINT_PATTERN = 0xA5A5A5A5u;
+
+    /**
+     * @brief Sicherheitsabstand unterhalb des aktuellen Stackpointers beim Bemalen (Byte).
+     */
+    static constexpr size_t PAINT_MARGIN = 64;
+
+    /**
+     * @brief Bemalt den ungenutzten Stack von Kern 0 (unterhalb des aktuellen Rahmens) und den gesamten Stack von Kern 1.
+     */
+    static void paint();
+
+    /**
+     * @brief Größe des Stacks eines Kerns in Byte.
+     * @param core Kern (0 oder 1)
+     */
+    static size_t sizeBytes(size_t core);
+
+    /**
+     * @brief Maximal genutzter Stack eines Kerns seit paint() in Byte (High-Water-Mark).
+     * @param core Kern (0 oder 1)
+     */
+    static size_t usedBytes(size_t core);
+
+    /**
+     * @brief Prüft die High-Water-Marks und meldet neue Höchststände über die Logging-API.
+     *
+     * @return true, wenn ein Kern einen neuen Höchststand erreicht hat
+     *
+     * @details Aufwand: ein Durchlauf über den noch unbenutzten Stackbereich (wenige µs).
+     */
+    static bool check();
+
+private:
+    /**
+     * @brief Untere (inkl.) und obere (exkl.) Stackgrenze eines Kerns.
+     */
+    static uint32_t* bottom(size_t core);
+    static uint32_t* top(size_t core);
+
+    /**
+     * @brief Zuletzt gemeldeter Höchststand je Kern (Byte).
+     */
+    static size_t reported[CORES];
+
+    /**
+     * @brief Gibt an, ob paint() aufgerufen wurde (sonst sind die Messwerte ungültig).
+     */
+    static bool painted;
+};
+
+#endif // STACK_MONITOR_H
@@ -0,0 +1,281 @@
+/**
+ * @file statusLed.cpp
+ * @brief Implementierung der Muster-Engine für die Onboard-LED.
+ *
+ * @author Knut Welzel <knut.welzel@gmail.com>
+ * @date 2025-09-13
+ * @copyright MIT
+ */
+
+#include "statusLed.h"
+#include "pico/stdlib.h"    // Für PICO_DEFAULT_LED_PIN
+#include "hardware/gpio.h"  // Für die Pinfunktion
+#include "hardware/pwm.h"   // Für die PWM-Ansteuerung
+#include "hardware/dma.h"   // Für das Hardware-Atmen
+#include "loadMeter.h"      // Für die IRQ-Zeitmessung
+
+namespace {
+
+using Segment = StatusLed::Segment;
+
+// Musterbeschreibung: die ersten `repeated` Segmente werden bei parametrierten Mustern N-mal gespielt
+struct PatternDef {
+    const Segment* segments;
+    uint8_t count;
+    uint8_t repeated;
+};
+
+// Segmenttabellen (Dauer in Schritten zu 20 ms)
+const Segment HEARTBEAT_SEGMENTS[] = {{255, 4, false}, {0, 6, false}, {255, 4, false}, {0, 36, false}};
+const Segment BREATHE_SEGMENTS[]   = {{255, 75, true}, {0, 75, true}, {0, 25, false}};
+const Segment BOOT_SEGMENTS[]      = {{255, 3, false}, {0, 5, false}, {0, 25, false}};
+const Segment ERROR_SEGMENTS[]     = {{255, 10, false}, {0, 15, false}, {0, 75, false}};
+const Segment FATAL_SEGMENTS[]     = {{255, 5, false}, {0, 5, false}};
+
+const PatternDef PATTERNS[static_cast<size_t>(StatusLed::Pattern::COUNT)] = {
+    {nullptr, 0, 0},                // OFF
+    {HEARTBEAT_SEGMENTS, 4, 0},     // HEARTBEAT
+    {BREATHE_SEGMENTS, 3, 0},       // BREATHE
+    {BOOT_SEGMENTS, 3, 2},          // BOOT
+    {ERROR_SEGMENTS, 3, 2},         // ERROR_CODE
+    {FATAL_SEGMENTS, 2, 0},         // FATAL
+};
+
+// Atem-Tabelle für die DMA: gleicher Verlauf wie BREATHE_SEGMENTS (75:75:25), quadratische Gammakurve,
+// Compare-Werte für Kanal B (GPIO25)
+struct BreatheTable {
+    uint16_t level[StatusLed::BREATHE_TABLE_LEN];
+};
+
+constexpr BreatheTable makeBreatheTable() {
+    BreatheTable table{};
+    constexpr uint32_t len = StatusLed::BREATHE_TABLE_LEN;
+    constexpr uint32_t rise = len * 75 / 175;
+    for (uint32_t i = 0; i < len; ++i) {
+        uint32_t level = 0;
+        if (i < rise) level = (i + 1) * 255 / rise;
+        else if (i < 2 * rise) level = (2 * rise - 1 - i) * 255 / rise;
+        table.level[i] = static_cast<uint16_t>((level * level * StatusLed::PWM_WRAP) / (255u * 255u));
+    }
+    return table;
+}
+
+// Tabelle und Startadresse liegen bewusst im RAM (.data, vom Startcode kopiert): Die DMA läuft frei
+// weiter, auch während CabinetConfig::save() den Flash löscht und XIP nicht gelesen werden darf
+BreatheTable breatheTable = makeBreatheTable();
+
+// Startadresse für den Steuerkanal (wird je Durchlauf in die Leseadresse des Datenkanals kopiert)
+const uint16_t* breatheTableStart = breatheTable.level;
+
+} // namespace
+
+volatile StatusLed::Pattern StatusLed::basePattern = StatusLed::Pattern::HEARTBEAT;
+volatile uint8_t StatusLed::bootStage = 0;
+volatile uint8_t StatusLed::errorCode = 0;
+volatile bool StatusLed::fatal = false;
+
+StatusLed::Pattern StatusLed::current = StatusLed::Pattern::COUNT;
+uint8_t StatusLed::param = 0;
+uint8_t StatusLed::segment = 0;
+uint8_t StatusLed::step = 0;
+uint8_t StatusLed::repeat = 0;
+uint8_t StatusLed::fromLevel = 0;
+int StatusLed::lastLevel = -1;
+
+repeating_timer_t StatusLed::timer = {};
+bool StatusLed::initialized = false;
+bool StatusLed::timerRunning = false;
+uint32_t StatusLed::pwmTop = 0;
+uint StatusLed::pwmSlice = 0;
+bool StatusLed::ownSlice = false;
+
+int StatusLed::dmaData = -1;
+int StatusLed::dmaCtrl = -1;
+bool StatusLed::hwBreathing = false;
+
+// Pinfunktion setzen; die Slice-Belegung prüft update() bei jedem Aufruf
+bool StatusLed::init() {
+    if (initialized) return timerRunning || hwBreathing;
+    pwmSlice = pwm_gpio_to_slice_num(PICO_DEFAULT_LED_PIN);
+    ownSlice = false;
+    gpio_set_function(PICO_DEFAULT_LED_PIN, GPIO_FUNC_PWM);
+    initialized = true;
+    update();
+    return timerRunning || hwBreathing;
+}
+
+// Belegt ein anderer Pin den Slice als PWM (Lichtkanal auf GPIO8/9/24), gelten dessen TOP und Teiler;
+// sonst den Slice (erneut) mit eigener Konfiguration übernehmen
+void StatusLed::checkSlice() {
+    bool shared = false;
+    for (uint gpio = 0; gpio < 30; ++gpio) {
+        if (gpio == PICO_DEFAULT_LED_PIN || pwm_gpio_to_slice_num(gpio) != pwmSlice) continue;
+        if (gpio_get_function(gpio) == GPIO_FUNC_PWM) shared = true;
+    }
+    if (shared) {
+        ownSlice = false;
+        pwmTop = pwm_hw->slice[pwmSlice].top;
+        lastLevel = -1;                 // Pegel mit neuem TOP neu schreiben
+        return;
+    }
+    if (ownSlice) return;
+    pwmTop = PWM_WRAP;
+    pwm_config config = pwm_get_default_config();
+    pwm_config_set_clkdiv_int(&config, PWM_CLKDIV);
+    pwm_config_set_wrap(&config, static_cast<uint16_t>(PWM_WRAP));
+    pwm_init(pwmSlice, &config, true);
+    ownSlice = true;
+    lastLevel = -1;
+    output(0);
+}
+
+void StatusLed::refresh() {
+    update();
+}
+
+void StatusLed::setBasePattern(Pattern pattern) {
+    if (pattern != Pattern::HEARTBEAT && pattern != Pattern::BREATHE && pattern != Pattern::OFF) return;
+    if (basePattern == pattern) return;
+    basePattern = pattern;
+    update();
+}
+
+void StatusLed::setBootStage(uint8_t stage) {
+    if (bootStage == stage) return;
+    bootStage = stage;
+    update();
+}
+
+void StatusLed::showErrorCode(uint8_t blinks) {
+    if (errorCode == blinks) return;
+    errorCode = blinks;
+    update();
+}
+
+void StatusLed::showFatal() {
+    fatal = true;
+    update();
+}
+
+// BREATHE ohne höher priorisierte Anzeige -> DMA, sonst Timer (bei OFF keiner).
+// Der Timer wird bei jeder Änderung neu gestartet, damit das neue Muster sofort von vorn beginnt.
+void StatusLed::update() {
+    if (!initialized) return;
+    checkSlice();
+    bool wantHw = ownSlice && !fatal && !errorCode && !bootStage && basePattern == Pattern::BREATHE;
+    if (timerRunning) {
+        cancel_repeating_timer(&timer);
+        timerRunning = false;
+    }
+    if (hwBreathing && !wantHw) stopBreathing();
+    if (wantHw && (hwBreathing || startBreathing())) return;
+
+    current = Pattern::COUNT;
+    if (!fatal && !errorCode && !bootStage && basePattern == Pattern::OFF) {
+        output(0);
+        return;
+    }
+    timerRunning = add_repeating_timer_ms(-static_cast<int32_t>(STEP_MS), timerCallback, nullptr, &timer);
+}
+
+// Datenkanal: 16-Bit-Schreibzugriffe auf das obere Halbwort von CC (Kanal B), getaktet vom PWM-Wrap;
+// Steuerkanal lädt danach die Startadresse nach. IO-Register werden stets 32 Bit breit geschrieben
+// (das Halbwort wird repliziert), Kanal A ändert sich also mit – daher nur bei eigenem Slice.
+bool StatusLed::startBreathing() {
+    if (!ownSlice) return false;
+    if (dmaData < 0) dmaData = dma_claim_unused_channel(false);
+    if (dmaCtrl < 0) dmaCtrl = dma_claim_unused_channel(false);
+    if (dmaData < 0 || dmaCtrl < 0) return false;
+
+    dma_channel_config data = dma_channel_get_default_config(dmaData);
+    channel_config_set_transfer_data_size(&data, DMA_SIZE_16);
+    channel_config_set_read_increment(&data, true);
+    channel_config_set_write_increment(&data, false);
+    channel_config_set_dreq(&data, DREQ_PWM_WRAP0 + pwmSlice);
+    channel_config_set_chain_to(&data, dmaCtrl);
+    volatile uint16_t* ccB = reinterpret_cast<volatile uint16_t*>(&pwm_hw->slice[pwmSlice].cc) + 1;
+    dma_channel_configure(dmaData, &data, ccB, breatheTable.level, BREATHE_TABLE_LEN, false);
+
+    dma_channel_config ctrl = dma_channel_get_default_config(dmaCtrl);
+    channel_config_set_transfer_data_size(&ctrl, DMA_SIZE_32);
+    channel_config_set_read_increment(&ctrl, false);
+    channel_config_set_write_increment(&ctrl, false);
+    dma_channel_configure(dmaCtrl, &ctrl, &dma_hw->ch[dmaData].al3_read_addr_trig, &breatheTableStart, 1, false);
+
+    dma_channel_start(dmaData);
+    hwBreathing = true;
+    return true;
+}
+
+// Steuerkanal zuerst anhalten, damit er den Datenkanal nicht neu anstößt
+void StatusLed::stopBreathing() {
+    dma_channel_abort(dmaCtrl);
+    dma_channel_abort(dmaData);
+    dma_channel_abort(dmaCtrl);
+    hwBreathing = false;
+    lastLevel = -1;
+    output(0);
+}
+
+// Quadratische Gammakurve: 0..255 -> 0..pwmTop; nur bei Änderung schreiben
+void StatusLed::output(uint8_t level) {
+    if (level == lastLevel) return;
+    lastLevel = level;
+    pwm_set_gpio_level(PICO_DEFAULT_LED_PIN, static_cast<uint16_t>((static_cast<uint32_t>(level) * level * pwmTop) / (255u * 255u)));
+}
+
+// Aktives Muster nach Priorität bestimmen; bei Wechsel von vorn beginnen, sonst einen Schritt weiter.
+// Segmente ohne Rampe werden mit einem Intervall übersprungen (weniger Aufwachvorgänge).
+bool StatusLed::timerCallback(repeating_timer_t* rt) {
+    LoadMeter::Scope load(LoadMeter::Bucket::IRQ);
+    Pattern want = basePattern;
+    uint8_t wantParam = 0;
+    if (fatal) {
+        want = Pattern::FATAL;
+    } else if (errorCode) {
+        want = Pattern::ERROR_CODE;
+        wantParam = errorCode;
+    } else if (bootStage) {
+        want = Pattern::BOOT;
+        wantParam = bootStage;
+    }
+    if (want != current || wantParam != param) {
+        current = want;
+        param = wantParam;
+        segment = step = repeat = 0;
+        fromLevel = lastLevel < 0 ? 0 : static_cast<uint8_t>(lastLevel);
+    }
+
+    const PatternDef& def = PATTERNS[static_cast<size_t>(current)];
+    if (!def.count) {
+        output(0);
+        rt->delay_us = -static_cast<int64_t>(STEP_MS) * 1000;
+        return true;
+    }
+
+    const Segment& seg = def.segments[segment];
+    uint8_t level = seg.level;
+    uint32_t steps = 1;
+    if (seg.ramp) {
+        int delta = static_cast<int>(seg.level) - fromLevel;
+        level = static_cast<uint8_t>(fromLevel + delta * (step + 1) / seg.steps);
+    } else {
+        steps = seg.steps - step;
+        step = seg.steps - 1;
+    }
+    output(level);
+    rt->delay_us = -static_cast<int64_t>(steps * STEP_MS) * 1000;
+
+    // Segmentende: nächstes Segment, Wiederholungsblock bzw. Musteranfang
+    if (++step >= seg.steps) {
+        step = 0;
+        fromLevel = seg.level;
+        ++segment;
+        if (def.repeated && segment == def.repeated && ++repeat < param) segment = 0;
+        if (segment >= def.count) {
+            segment = 0;
+            repeat = 0;
+        }
+    }
+    return true;
+}
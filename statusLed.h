@@ -0,0 +1,198 @@
+/**
+ * @file statusLed.h
+ * @brief Nicht blockierende Muster-Engine für die Onboard-LED (Header).
+ *
+ * Die Onboard-LED wird über PWM angesteuert; ein Timer-Callback spielt kodierte Muster ab und
+ * kostet keine Zeit in der Hauptschleife. Die Anzeige läuft daher auch weiter, wenn die
+ * Hauptschleife beschäftigt ist oder blockiert. Segmente ohne Rampe werden mit einem einzigen
+ * Timerintervall überbrückt, nur Rampen laufen in Schritten zu STEP_MS.
+ *
+ * \par Muster
+ * Ein Muster ist eine Folge von Segmenten {Helligkeit 0..255, Dauer in Schritten, Rampe}. Bei
+ * Rampensegmenten wird linear von der vorherigen Helligkeit übergeblendet (mit Gammakorrektur).
+ * Parametrierte Muster (Fehlercode, Bootstufe) wiederholen ihre ersten Segmente N-mal.
+ *
+ * \par Priorität
+ * FATAL > Fehlercode > Bootstufe > Grundmuster (HEARTBEAT, BREATHE oder OFF).
+ *
+ * \par Hardware-Atmen
+ * Ist BREATHE das aktive Muster, übernimmt die Hardware: Ein DMA-Kanal schreibt bei jedem
+ * PWM-Wrap (DREQ) den nächsten Wert einer Helligkeitstabelle im RAM in Kanal B des
+ * Compare-Registers, ein zweiter Kanal setzt am Tabellenende die Leseadresse zurück. Tabelle
+ * und Startadresse liegen im RAM, damit Flash-Schreibvorgänge (CabinetConfig::save()) die
+ * laufende DMA nicht stören. Der Timer wird gestoppt;
+ * die LED atmet ohne CPU, Interrupt oder Aufwachen. Die Lebendigkeit der Hauptschleife
+ * überwacht der Watchdog (Supervisor), nicht die LED.
+ *
+ * \par PWM
+ * PICO_DEFAULT_LED_PIN (GPIO25) liegt auf Slice 4, Kanal B, mit PWM_WRAP und PWM_CLKDIV
+ * (ca. 147 Hz, ein Tabellenwert je Periode). Die Belegung wird bei jeder Musteränderung und
+ * bei refresh() neu geprüft: Liegt ein Lichtkanal auf demselben Slice (GPIO8/9/24 als LED-Pin),
+ * werden dessen TOP-Wert und Teiler übernommen und nur der Timer genutzt.
+ *
+ * \author Knut Welzel <knut.welzel@gmail.com>
+ * \date 2025-09-13
+ * \copyright MIT
+ */
+
+#ifndef STATUS_LED_H
+#define STATUS_LED_H
+
+#include <cstdint>          // Für uint8_t, uint32_t
+#include "pico/time.h"      // Für repeating_timer_t
+
+/**
+ * @class StatusLed
+ * @brief Statische Muster-Engine auf PICO_DEFAULT_LED_PIN.
+ *
+ * \note Die Setter aus dem Hauptkontext aufrufen (nicht aus Interrupts): Sie schalten bei
+ *       Bedarf zwischen Timer und DMA um.
+ */
+class StatusLed {
+
+public:
+    /**
+     * @brief Abspielbare Muster.
+     */
+    enum class Pattern : uint8_t {
+        OFF        = 0,     ///< LED aus
+        HEARTBEAT  = 1,     ///< Doppelschlag im Sekundentakt
+        BREATHE    = 2,     ///< Langsames Atmen (Leerlauf)
+        BOOT       = 3,     ///< N schnelle Impulse je Bootstufe
+        ERROR_CODE = 4,     ///< N Impulse, Pause (Fehlercode)
+        FATAL      = 5,     ///< Schnelles Dauerblinken
+        COUNT      = 6      ///< Anzahl der Muster
+    };
+
+    /**
+     * @brief Ein Segment eines Musters.
+     */
+    struct Segment {
+        uint8_t level;      ///< Helligkeit am Segmentende (0..255, vor Gammakorrektur)
+        uint8_t steps;      ///< Dauer in Schritten zu STEP_MS (> 0)
+        bool ramp;          ///< true = linear überblenden, false = sofort springen
+    };
+
+    /**
+     * @brief Schrittweite des Timers (ms).
+     */
+    static constexpr uint32_t STEP_MS = 20;
+
+    /**
+     * @brief PWM-TOP und Taktteiler der Onboard-LED (125 MHz / 208 / 4096 ≈ 147 Hz).
+     */
+    static constexpr uint32_t PWM_WRAP = 4095;
+    static constexpr uint32_t PWM_CLKDIV = 208;
+
+    /**
+     * @brief Länge der Atem-Tabelle (ein Wert je PWM-Periode, 512 / 147 Hz ≈ 3,5 s).
+     */
+    static constexpr uint32_t BREATHE_TABLE_LEN = 512;
+
+    /**
+     * @brief Richtet PWM auf der Onboard-LED ein und startet den Timer (einmal früh in main()).
+     * @return true bei Erfolg, false wenn kein Timer angelegt werden konnte
+     */
+    static bool init();
+
+    /**
+     * @brief Setzt das Grundmuster (angezeigt, wenn kein Fehler und keine Bootstufe aktiv ist).
+     * @param pattern HEARTBEAT, BREATHE oder OFF
+     */
+    static void setBasePattern(Pattern pattern);
+
+    /**
+     * @brief Zeigt eine Bootstufe an (N schnelle Impulse); 0 beendet die Anzeige.
+     */
+    static void setBootStage(uint8_t stage);
+
+    /**
+     * @brief Zeigt einen Fehlercode an (N Impulse, Pause, Wiederholung); 0 beendet die Anzeige.
+     */
+    static void showErrorCode(uint8_t blinks);
+
+    /**
+     * @brief Gibt den angezeigten Fehlercode zurück (0 = keiner).
+     */
+    static uint8_t getErrorCode() { return errorCode; }
+
+    /**
+     * @brief Schaltet dauerhaft auf das FATAL-Muster (höchste Priorität).
+     */
+    static void showFatal();
+
+    /**
+     * @brief Gibt zurück, ob die LED gerade per DMA atmet (Timer gestoppt).
+     */
+    static bool isHardwareBreathing() { return hwBreathing; }
+
+    /**
+     * @brief Prüft die Slice-Belegung neu (nach Änderung der PWM-Pins, z.B. CabinetLight::setupPwmLEDs()).
+     */
+    static void refresh();
+
+private:
+    /**
+     * @brief Timer-Callback: ein Schritt des aktiven Musters.
+     */
+    static bool timerCallback(repeating_timer_t* rt);
+
+    /**
+     * @brief Setzt die LED-Helligkeit (0..255, quadratische Gammakurve auf den PWM-TOP-Wert).
+     */
+    static void output(uint8_t level);
+
+    /**
+     * @brief Wählt nach den aktuellen Anforderungen zwischen Timer und DMA-Atmen.
+     */
+    static void update();
+
+    /**
+     * @brief Bestimmt, ob der PWM-Slice der LED frei ist (eigene Konfiguration) oder mit einem Lichtkanal geteilt wird.
+     */
+    static void checkSlice();
+
+    /**
+     * @brief Startet bzw. stoppt die DMA-Kette für das Hardware-Atmen.
+     */
+    static bool startBreathing();
+    static void stopBreathing();
+
+    /**
+     * @brief Anforderungen (aus jedem Kontext gesetzt, im Timer-Callback ausgewertet).
+     */
+    static volatile Pattern basePattern;
+    static volatile uint8_t bootStage;
+    static volatile uint8_t errorCode;
+    static volatile bool fatal;
+
+    /**
+     * @brief Abspielzustand (nur Timer-Callback).
+     */
+    static Pattern current;
+    static uint8_t param;
+    static uint8_t segment;
+    static uint8_t step;
+    static uint8_t repeat;
+    static uint8_t fromLevel;
+    static int lastLevel;
+
+    /**
+     * @brief Timer, PWM-Slice und TOP-Wert.
+     */
+    static repeating_timer_t timer;
+    static bool initialized;
+    static bool timerRunning;
+    static uint32_t pwmTop;
+    static uint pwmSlice;
+    static bool ownSlice;
+
+    /**
+     * @brief DMA-Kanäle (Daten, Steuerung; -1 = nicht belegt) und Zustand des Hardware-Atmens.
+     */
+    static int dmaData;
+    static int dmaCtrl;
+    static bool hwBreathing;
+};
+
+#endif // STATUS_LED_H
@@ -0,0 +1,115 @@
+/**
+ * @file supervisor.cpp
+ * @brief Implementierung der Watchdog-Überwachung.
+ *
+ * @author Knut Welzel <knut.welzel@gmail.com>
+ * @date 2025-09-13
+ * @copyright MIT
+ */
+
+#include "supervisor.h"
+#include "cabinetLight.h"       // Für die Logging-API
+#include "pico/time.h"          // Für time_us_32()
+#include "hardware/watchdog.h"  // Für den Hardware-Watchdog und die Scratch-Register
+
+// Belegung der Scratch-Register
+static constexpr size_t SCRATCH_REASON = 0;
+static constexpr size_t SCRATCH_RESETS = 1;
+static constexpr size_t SCRATCH_LAST_TASK = 2;
+
+// Namen der Teilsysteme für Logmeldungen
+static const char* const taskNames[Supervisor::TASK_COUNT] = {"LOOP", "SENSOR", "RENDER"};
+
+uint32_t Supervisor::lastCheckInUs[TASK_COUNT] = {};
+uint32_t Supervisor::deadlineMs[TASK_COUNT] = {DEFAULT_DEADLINE_MS, DEFAULT_DEADLINE_MS, DEFAULT_DEADLINE_MS};
+bool Supervisor::running = false;
+bool Supervisor::tripped = false;
+absolute_time_t Supervisor::serviceNext = at_the_end_of_time;
+Supervisor::Stats Supervisor::stats = {};
+
+// Neustartgrund aus den Scratch-Registern bestimmen, Register für den nächsten Lauf vorbereiten, Watchdog starten
+void Supervisor::start() {
+    uint32_t reason = watchdog_hw->scratch[SCRATCH_REASON];
+    if (watchdog_caused_reboot()) {
+        stats.watchdogResets = watchdog_hw->scratch[SCRATCH_RESETS] + 1;
+        if (!watchdog_enable_caused_reboot()) {
+            stats.rebootReason = RebootReason::SOFTWARE;
+        } else if ((reason & 0xFFFF0000u) == SCRATCH_MAGIC && (reason & 0xFFu) < TASK_COUNT) {
+            stats.rebootReason = RebootReason::DEADLINE;
+            stats.rebootTask = static_cast<Task>(reason & 0xFFu);
+        } else {
+            uint32_t last = watchdog_hw->scratch[SCRATCH_LAST_TASK];
+            stats.rebootReason = RebootReason::HANG;
+            stats.rebootTask = static_cast<Task>(last < TASK_COUNT ? last : 0);
+        }
+    } else {
+        stats.rebootReason = RebootReason::COLD;
+        stats.watchdogResets = 0;
+    }
+    watchdog_hw->scratch[SCRATCH_REASON] = 0;
+    watchdog_hw->scratch[SCRATCH_RESETS] = stats.watchdogResets;
+
+    switch (stats.rebootReason) {
+        case RebootReason::DEADLINE:
+            CabinetLight::logWarn("Neustart durch Watchdog: Frist von %s überschritten (%u Watchdog-Neustarts)\n",
+                                  taskNames[static_cast<size_t>(stats.rebootTask)],
+                                  static_cast<unsigned>(stats.watchdogResets));
+            break;
+        case RebootReason::HANG:
+            CabinetLight::logWarn("Neustart durch Watchdog: Hänger nach %s (%u Watchdog-Neustarts)\n",
+                                  taskNames[static_cast<size_t>(stats.rebootTask)],
+                                  static_cast<unsigned>(stats.watchdogResets));
+            break;
+        case RebootReason::SOFTWARE:
+            CabinetLight::logInfo("Neustart per watchdog_reboot()\n");
+            break;
+        default:
+            break;
+    }
+
+    uint32_t now = time_us_32();
+    for (size_t t = 0; t < TASK_COUNT; ++t) lastCheckInUs[t] = now;
+    tripped = false;
+    running = true;
+    serviceNext = make_timeout_time_ms(SERVICE_INTERVAL_MS);
+    watchdog_enable(WATCHDOG_TIMEOUT_MS, true);     // Pausiert beim Debuggen
+}
+
+// Zeitstempel setzen und die Stelle für eine Hänger-Diagnose vermerken
+void Supervisor::checkIn(Task task) {
+    lastCheckInUs[static_cast<size_t>(task)] = time_us_32();
+    watchdog_hw->scratch[SCRATCH_LAST_TASK] = static_cast<uint32_t>(task);
+}
+
+// Intervalle seit der letzten Meldung prüfen; nur füttern, wenn alle innerhalb ihrer Frist liegen
+void Supervisor::service() {
+    if (!running) return;
+    uint32_t now = time_us_32();
+    for (size_t t = 0; t < TASK_COUNT; ++t) {
+        uint32_t intervalMs = (now - lastCheckInUs[t]) / 1000;
+        if (intervalMs > stats.maxIntervalMs[t]) stats.maxIntervalMs[t] = intervalMs;
+        if (intervalMs > deadlineMs[t]) {
+            if (!tripped) {
+                tripped = true;
+                watchdog_hw->scratch[SCRATCH_REASON] = SCRATCH_MAGIC | static_cast<uint32_t>(t);
+                LOG_ERROR(SYS, "%s: Frist überschritten (%u ms > %u ms), Watchdog-Neustart\n", taskNames[t],
+                          static_cast<unsigned>(intervalMs), static_cast<unsigned>(deadlineMs[t]));
+            }
+        } else if (intervalMs * 100 >= deadlineMs[t] * NEAR_MISS_PERCENT) {
+            ++stats.nearMisses;
+            LOG_WARN(SYS, "Schleifenlatenz %s: %u ms (Frist %u ms)\n", taskNames[t],
+                     static_cast<unsigned>(intervalMs), static_cast<unsigned>(deadlineMs[t]));
+        }
+    }
+    checkIn(Task::LOOP);
+    serviceNext = make_timeout_time_ms(SERVICE_INTERVAL_MS);
+    if (!tripped) watchdog_update();
+}
+
+void Supervisor::setDeadline(Task task, uint32_t ms) {
+    if (task >= Task::COUNT) {
+        CabinetLight::logError("setDeadline: ungültiges Teilsystem %d\n", static_cast<int>(task));
+        return;
+    }
+    deadlineMs[static_cast<size_t>(task)] = ms;
+}
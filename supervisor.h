@@ -0,0 +1,173 @@
+/**
+ * @file supervisor.h
+ * @brief Watchdog-Überwachung mit Fristen je Teilsystem und Neustartgrund (Header).
+ *
+ * Die Teilsysteme melden sich mit checkIn() (Sensorstufe, Renderstufe, Hauptschleife). Die
+ * Hauptschleife ruft service() auf: Der Hardware-Watchdog wird nur gefüttert, wenn sich jedes
+ * Teilsystem innerhalb seiner Frist gemeldet hat. Überschreitet ein Teilsystem seine Frist, wird
+ * der Watchdog nicht mehr gefüttert und löst nach WATCHDOG_TIMEOUT_MS einen Neustart aus.
+ * Intervalle ab NEAR_MISS_PERCENT der Frist werden als Latenzwarnung gemeldet (LOG_WARN, SYS).
+ *
+ * \par Aufwachen im Leerlauf
+ * Die Lebendigkeit der Hauptschleife prüft allein der Watchdog. Im Leerlauf weckt nextService()
+ * die Schleife spätestens alle SERVICE_INTERVAL_MS; ein eigener Heartbeat-Takt entfällt.
+ *
+ * \par Neustartgrund
+ * Die Scratch-Register des Watchdogs überdauern einen Watchdog-Reset:
+ * - scratch[0]: Kennung und Teilsystem bei Fristüberschreitung
+ * - scratch[1]: Anzahl der Watchdog-Neustarts seit dem letzten Kaltstart
+ * - scratch[2]: Zuletzt gemeldetes Teilsystem (bei einem Hänger die Stelle, nach der es stehen blieb)
+ * start() wertet sie aus, meldet den Grund und stellt ihn über getStats() für Telemetrie bereit.
+ * scratch[4..7] bleiben dem Pico-SDK vorbehalten.
+ *
+ * \author Knut Welzel <knut.welzel@gmail.com>
+ * \date 2025-09-13
+ * \copyright MIT
+ */
+
+#ifndef SUPERVISOR_H
+#define SUPERVISOR_H
+
+#include <cstdint>          // Für uint32_t
+#include <cstddef>          // Für size_t
+#include <array>            // Für std::array
+#include "pico/time.h"      // Für absolute_time_t
+
+/**
+ * @class Supervisor
+ * @brief Statische Watchdog-Überwachung der Hauptschleife.
+ *
+ * \note Alle Methoden dürfen nur aus der Hauptschleife aufgerufen werden.
+ */
+class Supervisor {
+
+public:
+    /**
+     * @brief Überwachte Teilsysteme.
+     */
+    enum class Task : uint8_t {
+        LOOP   = 0,     ///< Hauptschleife (Meldung in service())
+        SENSOR = 1,     ///< Sensorstufe von CabinetLight::process()
+        RENDER = 2,     ///< Renderstufe von CabinetLight::process()
+        COUNT  = 3      ///< Anzahl der Teilsysteme
+    };
+
+    /**
+     * @brief Grund des letzten Neustarts.
+     */
+    enum class RebootReason : uint8_t {
+        COLD     = 0,   ///< Einschalten, RUN-Pin oder System-Reset (z.B. nach HardFault, siehe CrashReport)
+        DEADLINE = 1,   ///< Watchdog nach Fristüberschreitung eines Teilsystems
+        HANG     = 2,   ///< Watchdog ohne Aufruf von service() (Hänger)
+        SOFTWARE = 3    ///< watchdog_reboot() (z.B. picotool, Firmware-Update)
+    };
+
+    /**
+     * @brief Anzahl der Teilsysteme.
+     */
+    static constexpr size_t TASK_COUNT = static_cast<size_t>(Task::COUNT);
+
+    /**
+     * @brief Timeout des Hardware-Watchdogs (ms).
+     */
+    static constexpr uint32_t WATCHDOG_TIMEOUT_MS = 8000;
+
+    /**
+     * @brief Standardfrist je Teilsystem (ms); die Hauptschleife läuft mindestens alle SERVICE_INTERVAL_MS.
+     */
+    static constexpr uint32_t DEFAULT_DEADLINE_MS = 6000;
+
+    /**
+     * @brief Längster Abstand zwischen zwei service()-Aufrufen im Leerlauf (ms).
+     */
+    static constexpr uint32_t SERVICE_INTERVAL_MS = 4000;
+
+    /**
+     * @brief Schwelle für Latenzwarnungen in Prozent der Frist.
+     */
+    static constexpr uint32_t NEAR_MISS_PERCENT = 75;
+    static_assert(WATCHDOG_TIMEOUT_MS <= 8388, "RP2040-Watchdog: höchstens 8,3 s");
+    static_assert(DEFAULT_DEADLINE_MS < WATCHDOG_TIMEOUT_MS, "Frist muss vor dem Watchdog greifen");
+    static_assert(SERVICE_INTERVAL_MS * 100 < DEFAULT_DEADLINE_MS * NEAR_MISS_PERCENT,
+                  "Leerlaufintervall würde Latenzwarnungen auslösen");
+
+    /**
+     * @brief Kennung in scratch[0] (obere 16 Bit).
+     */
+    static constexpr uint32_t SCRATCH_MAGIC = 0x5D0C0000u;
+
+    /**
+     * @brief Telemetrie.
+     */
+    struct Stats {
+        RebootReason rebootReason;                      ///< Grund des letzten Neustarts
+        Task rebootTask;                                ///< Betroffenes Teilsystem (bei DEADLINE/HANG)
+        uint32_t watchdogResets;                        ///< Watchdog-Neustarts seit dem letzten Kaltstart
+        uint32_t nearMisses;                            ///< Latenzwarnungen seit start()
+        std::array<uint32_t, TASK_COUNT> maxIntervalMs; ///< Längstes Intervall zwischen zwei Meldungen je Teilsystem
+    };
+
+    /**
+     * @brief Wertet den Neustartgrund aus, meldet ihn und aktiviert den Watchdog.
+     *
+     * @details Aufruf unmittelbar vor der Hauptschleife (nach Initialisierung und Startup-Test).
+     */
+    static void start();
+
+    /**
+     * @brief Meldung eines Teilsystems.
+     */
+    static void checkIn(Task task);
+
+    /**
+     * @brief Prüft alle Fristen und füttert den Watchdog, wenn keine überschritten ist (einmal je Schleifendurchlauf).
+     */
+    static void service();
+
+    /**
+     * @brief Spätester Zeitpunkt des nächsten service()-Aufrufs (Weckzeit der Hauptschleife).
+     * @return at_the_end_of_time, solange der Watchdog nicht läuft
+     */
+    static absolute_time_t nextService() { return serviceNext; }
+
+    /**
+     * @brief Setzt die Frist eines Teilsystems.
+     * @param task Teilsystem
+     * @param ms   Frist in ms (muss unter WATCHDOG_TIMEOUT_MS liegen, sonst greift der Watchdog zuerst)
+     */
+    static void setDeadline(Task task, uint32_t ms);
+
+    /**
+     * @brief Gibt die Telemetriewerte zurück.
+     */
+    static Stats getStats() { return stats; }
+
+private:
+    /**
+     * @brief Zeitpunkt der letzten Meldung je Teilsystem (time_us_32()).
+     */
+    static uint32_t lastCheckInUs[TASK_COUNT];
+
+    /**
+     * @brief Frist je Teilsystem (ms).
+     */
+    static uint32_t deadlineMs[TASK_COUNT];
+
+    /**
+     * @brief Watchdog aktiv bzw. Frist überschritten (Watchdog wird nicht mehr gefüttert).
+     */
+    static bool running;
+    static bool tripped;
+
+    /**
+     * @brief Spätester Zeitpunkt des nächsten service()-Aufrufs.
+     */
+    static absolute_time_t serviceNext;
+
+    /**
+     * @brief Telemetrie.
+     */
+    static Stats stats;
+};
+
+#endif // SUPERVISOR_H
@@ -0,0 +1,221 @@
+#!/usr/bin/env python3
+# ==============================================================================
+#  File: tools/footprint.py
+#  Project: Schrankbeleuchtung
+#  Description: RAM/flash footprint report from the linker map file, with
+#               per translation unit and per symbol breakdown and budgets
+#  Author: Knut Welzel
+#  Email: knut.welzel@gmail.com
+#  Created: 2025-09-13
+#  License: MIT
+# ==============================================================================
+#
+# Usage:
+#   python3 tools/footprint.py --map Schrankbeleuchtung.elf.map \
+#       [--elf Schrankbeleuchtung.elf --nm arm-none-eabi-nm] \
+#       [--flash-budget 262144] [--ram-budget 65536] [--top 25] [--summary-only]
+#   python3 tools/footprint.py --self-test
+#
+# Flash = .text + .rodata + .data (initial values are stored in flash)
+# RAM   = .data + .bss (stacks and heap are not included)
+#
+# The exit code is 1 if a budget (> 0) is exceeded, so the report can fail the
+# build.
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+from collections import defaultdict
+
+FLASH_SIZE = 2 * 1024 * 1024
+RAM_SIZE = 264 * 1024
+KINDS = ("text", "rodata", "data", "bss")
+
+# Output section -> category (RP2040 memmap_default.ld)
+OUTPUT_KIND = {
+    ".boot2": "text", ".text": "text",
+    ".rodata": "rodata", ".ARM.extab": "rodata", ".ARM.exidx": "rodata", ".binary_info": "rodata",
+    ".data": "data", ".scratch_x": "data", ".scratch_y": "data",
+    ".ram_vector_table": "bss", ".uninitialized_data": "bss", ".bss": "bss",
+}
+
+INPUT_LINE = re.compile(r"^ (\S+)?\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+WRAPPED_NAME = re.compile(r"^ \.\S+$")
+NM_KIND = {"t": "text", "r": "rodata", "d": "data", "b": "bss"}
+
+
+def unit_name(obj):
+    """Short translation unit name: 'main.cpp' or 'libc_nano.a(lib_a-vfprintf.o)'."""
+    obj = obj.strip()
+    match = re.match(r"^(.*\.a)\((.*)\)$", obj)
+    if match:
+        return "%s(%s)" % (os.path.basename(match.group(1)), match.group(2))
+    name = os.path.basename(obj)
+    return name[:-4] if name.endswith(".obj") else name
+
+
+def library_name(unit):
+    """Group of a translation unit: archive name or 'firmware/sdk objects'."""
+    return unit.split("(")[0] if "(" in unit else "objects"
+
+
+def parse_map(path):
+    """Returns {unit: {kind: bytes}} for all input sections of the allocated output sections."""
+    units = defaultdict(lambda: dict.fromkeys(KINDS, 0))
+    kind = None
+    pending = None
+    started = False
+    with open(path, encoding="utf-8", errors="replace") as f:
+        for line in f:
+            line = line.rstrip("\n")
+            if not started:
+                started = line.startswith("Linker script and memory map")
+                continue
+            # Output section header (column 0)
+            if line.startswith("."):
+                kind = OUTPUT_KIND.get(line.split()[0])
+                pending = None
+                continue
+            if kind is None or line.startswith(" *fill*"):
+                continue
+            # Long input section names wrap onto the next line; linker script patterns such as
+            # " *(.bss*)" stand alone as well but are not section names
+            if pending is None and WRAPPED_NAME.match(line):
+                pending = line
+                continue
+            if pending is not None:
+                line, pending = pending + line, None
+            match = INPUT_LINE.match(line)
+            if not match or match.group(1) is None:
+                continue
+            size = int(match.group(3), 16)
+            if size and not match.group(4).startswith("0x"):
+                units[unit_name(match.group(4))][kind] += size
+    return units
+
+
+# Map excerpt for --self-test: wrapped section name, pattern lines directly before
+# an input section, *fill* and a symbol line
+SAMPLE_MAP = """\
+Memory Configuration
+
+Linker script and memory map
+
+.text           0x10000100      0x100
+ *(.text*)
+ .text._ZN12CabinetLight6updateEv
+                0x10000100       0x40 CMakeFiles/app.dir/cabinetLight.cpp.obj
+                0x10000100                CabinetLight::update()
+ *(.rodata*)
+ .text.main     0x10000140       0x30 CMakeFiles/app.dir/main.cpp.obj
+ *fill*         0x10000170        0x2 
+.data           0x20000000       0x10
+ *(.data*)
+ .data.config   0x20000000       0x10 CMakeFiles/app.dir/main.cpp.obj
+.bss            0x20000010       0x34
+ *(.bss*)
+ .bss.ring      0x20000010       0x20 CMakeFiles/app.dir/trace.cpp.obj
+ *(COMMON)
+ .bss.errno     0x20000030        0x4 /opt/lib/libc_nano.a(lib_a-errno.o)
+"""
+
+
+def self_test():
+    """Parses SAMPLE_MAP and checks the per-unit sizes; returns the exit code."""
+    import tempfile
+    expected = {
+        "cabinetLight.cpp": {"text": 0x40, "rodata": 0, "data": 0, "bss": 0},
+        "main.cpp": {"text": 0x30, "rodata": 0, "data": 0x10, "bss": 0},
+        "trace.cpp": {"text": 0, "rodata": 0, "data": 0, "bss": 0x20},
+        "libc_nano.a(lib_a-errno.o)": {"text": 0, "rodata": 0, "data": 0, "bss": 0x4},
+    }
+    with tempfile.NamedTemporaryFile("w", suffix=".map", delete=False) as f:
+        f.write(SAMPLE_MAP)
+    try:
+        units = {unit: dict(sizes) for unit, sizes in parse_map(f.name).items()}
+    finally:
+        os.unlink(f.name)
+    if units != expected:
+        print("self-test failed:\n  expected %s\n  got      %s" % (expected, units), file=sys.stderr)
+        return 1
+    print("self-test passed")
+    return 0
+
+
+def parse_nm(nm, elf):
+    """Returns [(size, kind, name)] for all sized symbols of the ELF file."""
+    out = subprocess.run([nm, "--print-size", "--size-sort", "--radix=d", "-C", elf],
+                         check=True, capture_output=True, text=True).stdout
+    symbols = []
+    for line in out.splitlines():
+        parts = line.split(None, 3)
+        if len(parts) == 4 and parts[2].lower() in NM_KIND:
+            symbols.append((int(parts[1]), NM_KIND[parts[2].lower()], parts[3]))
+    return symbols
+
+
+def main():
+    parser = argparse.ArgumentParser(description="RAM/flash footprint report")
+    parser.add_argument("--map", help="linker map file (<target>.elf.map)")
+    parser.add_argument("--elf", help="ELF file for the per-symbol breakdown")
+    parser.add_argument("--nm", default="arm-none-eabi-nm", help="nm of the toolchain")
+    parser.add_argument("--flash-budget", type=int, default=0, help="flash budget in bytes (0 = none)")
+    parser.add_argument("--ram-budget", type=int, default=0, help="RAM budget in bytes (0 = none)")
+    parser.add_argument("--top", type=int, default=25, help="number of entries per list")
+    parser.add_argument("--summary-only", action="store_true", help="print totals and budgets only")
+    parser.add_argument("--self-test", action="store_true", help="check the map parser against a built-in sample")
+    args = parser.parse_args()
+    if args.self_test:
+        return self_test()
+    if not args.map:
+        parser.error("--map is required")
+
+    units = parse_map(args.map)
+    totals = dict.fromkeys(KINDS, 0)
+    for sizes in units.values():
+        for kind in KINDS:
+            totals[kind] += sizes[kind]
+    flash = totals["text"] + totals["rodata"] + totals["data"]
+    ram = totals["data"] + totals["bss"]
+
+    print("Footprint: text %d, rodata %d, data %d, bss %d" % tuple(totals[k] for k in KINDS))
+    print("Flash %7d B (%5.1f %% of %d)" % (flash, 100.0 * flash / FLASH_SIZE, FLASH_SIZE))
+    print("RAM   %7d B (%5.1f %% of %d, without stacks/heap)" % (ram, 100.0 * ram / RAM_SIZE, RAM_SIZE))
+
+    if not args.summary_only:
+        header = "%8s %8s %8s %8s  %s"
+        print("\nPer library:")
+        print(header % ("text", "rodata", "data", "bss", "library"))
+        libraries = defaultdict(lambda: dict.fromkeys(KINDS, 0))
+        for unit, sizes in units.items():
+            for kind in KINDS:
+                libraries[library_name(unit)][kind] += sizes[kind]
+        for lib, sizes in sorted(libraries.items(), key=lambda e: -sum(e[1].values())):
+            print(header % (sizes["text"], sizes["rodata"], sizes["data"], sizes["bss"], lib))
+
+        print("\nLargest translation units:")
+        print(header % ("text", "rodata", "data", "bss", "unit"))
+        for unit, sizes in sorted(units.items(), key=lambda e: -sum(e[1].values()))[:args.top]:
+            print(header % (sizes["text"], sizes["rodata"], sizes["data"], sizes["bss"], unit))
+
+        if args.elf:
+            symbols = parse_nm(args.nm, args.elf)
+            for title, kinds in (("flash (text/rodata/data)", ("text", "rodata", "data")), ("RAM (data/bss)", ("data", "bss"))):
+                print("\nLargest symbols in %s:" % title)
+                for size, kind, name in sorted((s for s in symbols if s[1] in kinds), key=lambda s: -s[0])[:args.top]:
+                    print("%8d  %-6s  %s" % (size, kind, name))
+
+    failed = False
+    for label, used, budget in (("Flash", flash, args.flash_budget), ("RAM", ram, args.ram_budget)):
+        if budget and used > budget:
+            print("error: %s footprint %d B exceeds budget %d B by %d B" % (label, used, budget, used - budget), file=sys.stderr)
+            failed = True
+        elif budget:
+            print("%s budget: %d of %d B (%d B left)" % (label, used, budget, budget - used))
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
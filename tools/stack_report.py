@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+# ==============================================================================
+#  File: tools/stack_report.py
+#  Project: Schrankbeleuchtung
+#  Description: Aggregates the -fstack-usage output (.su files) of the firmware
+#               target into a sorted report
+#  Author: Knut Welzel
+#  Email: knut.welzel@gmail.com
+#  Created: 2025-09-13
+#  License: MIT
+# ==============================================================================
+#
+# Usage:
+#   python3 tools/stack_report.py build/CMakeFiles/Schrankbeleuchtung.dir [-n 30]
+#
+# Each .su line has the form "file:line:col:function<TAB>bytes<TAB>qualifier".
+# The qualifier is "static", "dynamic" or "dynamic,bounded". Frames marked
+# dynamic (alloca, VLAs) have no fixed size and are listed separately.
+
+import argparse
+import os
+import re
+import sys
+from collections import defaultdict
+
+LOCATION = re.compile(r"^(.*?):(\d+):(\d+):(.*)$")
+
+
+def read_su(root):
+    """Yields (source, function, bytes, qualifier) for all .su files below root."""
+    for dirpath, _, files in os.walk(root):
+        for name in files:
+            if not name.endswith(".su"):
+                continue
+            with open(os.path.join(dirpath, name), encoding="utf-8", errors="replace") as f:
+                for line in f:
+                    parts = line.rstrip("\n").split("\t")
+                    if len(parts) != 3:
+                        continue
+                    location, size, qualifier = parts
+                    match = LOCATION.match(location)
+                    if match:
+                        source, function = os.path.basename(match.group(1)), match.group(4)
+                        # GCC prints only ")" for some variadic functions
+                        if function == ")":
+                            function = "<variadic function at line %s>" % match.group(2)
+                    else:
+                        source, function = "?", location
+                    yield source, function, int(size), qualifier
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Aggregate -fstack-usage output")
+    parser.add_argument("root", help="object directory of the firmware target")
+    parser.add_argument("-n", "--top", type=int, default=25, help="number of largest frames to list")
+    args = parser.parse_args()
+
+    entries = list(read_su(args.root))
+    if not entries:
+        print("no .su files found below %s (build with -fstack-usage first)" % args.root, file=sys.stderr)
+        return 1
+
+    print("Largest stack frames:")
+    print("%8s  %-16s  %-24s  %s" % ("bytes", "qualifier", "file", "function"))
+    for source, function, size, qualifier in sorted(entries, key=lambda e: -e[2])[:args.top]:
+        print("%8d  %-16s  %-24s  %s" % (size, qualifier, source, function))
+
+    per_file = defaultdict(lambda: [0, 0])
+    for source, _, size, _ in entries:
+        per_file[source][0] = max(per_file[source][0], size)
+        per_file[source][1] += 1
+    print("\nPer file (largest frame, functions):")
+    for source, (largest, count) in sorted(per_file.items(), key=lambda e: -e[1][0]):
+        print("%8d  %4d  %s" % (largest, count, source))
+
+    dynamic = [e for e in entries if e[3].startswith("dynamic")]
+    if dynamic:
+        print("\nDynamic frames (size not fixed at compile time):")
+        for source, function, size, qualifier in dynamic:
+            print("%8d  %-16s  %-24s  %s" % (size, qualifier, source, function))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+# ==============================================================================
+#  File: tools/trace2chrome.py
+#  Project: Schrankbeleuchtung
+#  Description: Converts the TRACE output of Trace::dump() into Chrome trace JSON
+#               (chrome://tracing, https://ui.perfetto.dev)
+#  Author: Knut Welzel
+#  Email: knut.welzel@gmail.com
+#  Created: 2025-09-13
+#  License: MIT
+# ==============================================================================
+#
+# Usage:
+#   python3 tools/trace2chrome.py serial.log > trace.json
+#   python3 tools/trace2chrome.py real.log sim.log -o compare.json
+#
+# Every input file becomes its own process (pid) in the trace, so recordings
+# from different runs can be compared side by side. Lines that do not start
+# with "TRACE " (regular log output) are ignored.
+
+import argparse
+import json
+import sys
+
+TRACKS = {0: "main", 1: "irq", 2: "usb"}
+
+
+def parse(lines, pid):
+    """Yields Chrome trace events for all TRACE lines of one recording."""
+    last_raw = None
+    offset = 0
+    for line in lines:
+        parts = line.strip().split(" ", 4)
+        if len(parts) != 5 or parts[0] != "TRACE":
+            continue
+        _, ts, phase, track, name = parts
+        raw = int(ts)
+        # time_us_32() wraps after about 71 minutes. Only a drop of more than half the
+        # range is a wrap; small backward steps come from events recorded in an interrupt
+        # between slot allocation and timestamp and stay as they are.
+        if last_raw is not None and last_raw - raw > 1 << 31:
+            offset += 1 << 32
+        last_raw = raw
+        ts = raw + offset
+        event = {"name": name, "ph": phase, "ts": ts, "pid": pid, "tid": int(track)}
+        if phase == "I":
+            event["s"] = "t"
+        yield event
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert Trace::dump() output to Chrome trace JSON")
+    parser.add_argument("inputs", nargs="+", help="log files containing TRACE lines")
+    parser.add_argument("-o", "--output", help="output file (default: stdout)")
+    args = parser.parse_args()
+
+    events = []
+    for pid, path in enumerate(args.inputs):
+        with open(path, encoding="utf-8", errors="replace") as f:
+            events.extend(parse(f, pid))
+        events.append({"name": "process_name", "ph": "M", "pid": pid, "args": {"name": path}})
+        for tid, label in TRACKS.items():
+            events.append({"name": "thread_name", "ph": "M", "pid": pid, "tid": tid, "args": {"name": label}})
+
+    out = open(args.output, "w", encoding="utf-8") if args.output else sys.stdout
+    json.dump({"traceEvents": events, "displayTimeUnit": "ms"}, out)
+    if args.output:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()
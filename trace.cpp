@@ -0,0 +1,70 @@
+/**
+ * @file trace.cpp
+ * @brief Implementierung des Trace-Ringpuffers.
+ *
+ * @author Knut Welzel <knut.welzel@gmail.com>
+ * @date 2025-09-13
+ * @copyright MIT
+ */
+
+#include "trace.h"
+#include "logFormat.h"
+
+#include <cstdio>
+
+// Statischer Ringpuffer
+Trace::Event Trace::events[TRACE_BUFFER_SIZE] = {};
+std::atomic<uint32_t> Trace::head {0};
+std::atomic<bool> Trace::enabled {true};
+
+// Slot atomar vergeben und beschreiben (überschreibt bei vollem Puffer den ältesten Eintrag)
+void Trace::record(Phase phase, Track track, const char* name) {
+    if (!enabled.load(std::memory_order_relaxed)) return;
+    uint32_t slot = head.fetch_add(1, std::memory_order_relaxed) & (TRACE_BUFFER_SIZE - 1);
+    Event& ev = events[slot];
+    ev.timeUs = TRACE_CLOCK_US();
+    ev.name = name;
+    ev.phase = phase;
+    ev.track = track;
+}
+
+// Letzte Einträge in zeitlicher Reihenfolge kopieren
+size_t Trace::copyLast(Event* out, size_t max) {
+    uint32_t total = head.load(std::memory_order_relaxed);
+    uint32_t count = total < TRACE_BUFFER_SIZE ? total : TRACE_BUFFER_SIZE;
+    if (count > max) count = static_cast<uint32_t>(max);
+    uint32_t first = total - count;
+    for (uint32_t i = 0; i < count; ++i) {
+        out[i] = events[(first + i) & (TRACE_BUFFER_SIZE - 1)];
+    }
+    return count;
+}
+
+// Ausgabe in zeitlicher Reihenfolge; tools/trace2chrome.py wertet die TRACE-Zeilen aus
+// Formatierung über LogFormat, damit das Tracing kein printf benötigt
+void Trace::dump() {
+    bool wasEnabled = enabled.exchange(false, std::memory_order_acquire);
+    uint32_t total = head.load(std::memory_order_relaxed);
+    uint32_t count = total < TRACE_BUFFER_SIZE ? total : TRACE_BUFFER_SIZE;
+    uint32_t first = total - count;
+
+    char line[64];
+    LogFormat::format(line, sizeof(line), "TRACE-BEGIN %lu\n", static_cast<unsigned long>(count));
+    fputs(line, stdout);
+    for (uint32_t i = 0; i < count; ++i) {
+        const Event& ev = events[(first + i) & (TRACE_BUFFER_SIZE - 1)];
+        LogFormat::format(line, sizeof(line), "TRACE %lu %c %u %s\n", static_cast<unsigned long>(ev.timeUs),
+                          static_cast<char>(ev.phase), static_cast<unsigned>(ev.track), ev.name ? ev.name : "?");
+        fputs(line, stdout);
+        // Nicht blockierende Senken (LogSink) zwischendurch leeren, damit nichts verworfen wird:
+        // erst den Puffer der C-Bibliothek, dann die Treiber
+        fflush(stdout);
+        TRACE_FLUSH();
+    }
+    fputs("TRACE-END\n", stdout);
+    fflush(stdout);
+    TRACE_FLUSH();
+
+    head.store(0, std::memory_order_relaxed);
+    enabled.store(wasEnabled, std::memory_order_release);
+}
@@ -0,0 +1,188 @@
+/**
+ * @file trace.h
+ * @brief Leichtgewichtiges Tracing: Spans und Einzelereignisse in einem RAM-Ringpuffer (Header).
+ *
+ * Begin/End-Spans und Einzelereignisse werden mit Zeitstempel, Spur (Hauptschleife, IRQ, USB) und
+ * Namen in einen Ringpuffer geschrieben. Trace::dump() gibt den Puffer zeilenweise über stdio aus,
+ * tools/trace2chrome.py wandelt die Ausgabe in das Chrome-Trace-Format (chrome://tracing, Perfetto).
+ *
+ * \par Aktivierung
+ * Die Makros TRACE_BEGIN, TRACE_END, TRACE_INSTANT und TRACE_SCOPE erzeugen nur Code, wenn
+ * CABINET_TRACE definiert ist (CMake-Option CABINET_TRACE). Ohne die Option entfällt das Tracing vollständig.
+ *
+ * \par Portabilität
+ * Die Klasse nutzt außer Zeitquelle und Ausgabe-Flush nur Standard-C++. Beide sind über
+ * TRACE_CLOCK_US() und TRACE_FLUSH() austauschbar (Standard: time_us_32() bzw. stdio_flush()),
+ * sodass derselbe Code auch in Host-Builds läuft.
+ *
+ * \par Ausgabeformat von dump()
+ * \code
+ * TRACE-BEGIN <anzahl>
+ * TRACE <zeit_us> <B|E|I> <spur> <name>
+ * TRACE-END
+ * \endcode
+ *
+ * \author Knut Welzel <knut.welzel@gmail.com>
+ * \date 2025-09-13
+ * \copyright MIT
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <cstdint>          // Für uint8_t, uint32_t
+#include <cstddef>          // Für size_t
+#include <atomic>           // Für std::atomic
+
+#ifndef TRACE_CLOCK_US
+#include "pico/time.h"      // Für time_us_32()
+/**
+ * @brief Zeitquelle des Tracings in µs (für Host-Builds vor dem Einbinden umdefinierbar).
+ */
+#define TRACE_CLOCK_US() time_us_32()
+#endif
+
+#ifndef TRACE_FLUSH
+#include "pico/stdio.h"     // Für stdio_flush()
+/**
+ * @brief Leert die Ausgabe bis in die Treiber (für Host-Builds vor dem Einbinden umdefinierbar).
+ *
+ * stdio_flush() ruft out_flush der stdio-Treiber (LogSink::flush()); fflush(stdout) allein leert
+ * nur den Puffer der C-Bibliothek.
+ */
+#define TRACE_FLUSH() stdio_flush()
+#endif
+
+/**
+ * @brief Anzahl der Einträge im Ringpuffer (Zweierpotenz, 12 Byte je Eintrag).
+ */
+#ifndef TRACE_BUFFER_SIZE
+#define TRACE_BUFFER_SIZE 256
+#endif
+
+/**
+ * @class Trace
+ * @brief Statischer Ringpuffer für Trace-Ereignisse.
+ *
+ * \note record() ist aus Hauptschleife und IRQ aufrufbar (Slot-Vergabe über einen atomaren Zähler).
+ * Bei vollem Puffer werden die ältesten Einträge überschrieben.
+ */
+class Trace {
+
+public:
+    /**
+     * @brief Art eines Ereignisses (entspricht "ph" im Chrome-Trace-Format).
+     */
+    enum class Phase : uint8_t {
+        BEGIN   = 'B',  ///< Beginn eines Spans
+        END     = 'E',  ///< Ende eines Spans
+        INSTANT = 'I'   ///< Einzelereignis
+    };
+
+    /**
+     * @brief Spur eines Ereignisses (entspricht "tid" im Chrome-Trace-Format).
+     */
+    enum class Track : uint8_t {
+        MAIN = 0,       ///< Hauptschleife
+        IRQ  = 1,       ///< Interrupt-Handler
+        USB  = 2        ///< stdio-/USB-Ausgabe
+    };
+
+    /**
+     * @brief Ein Eintrag im Ringpuffer.
+     */
+    struct Event {
+        uint32_t timeUs;    ///< Zeitstempel (TRACE_CLOCK_US())
+        const char* name;   ///< Name (String-Literal, muss dauerhaft gültig sein)
+        Phase phase;        ///< Art
+        Track track;        ///< Spur
+    };
+
+    static_assert((TRACE_BUFFER_SIZE & (TRACE_BUFFER_SIZE - 1)) == 0, "TRACE_BUFFER_SIZE muss eine Zweierpotenz sein");
+
+    /**
+     * @brief Schreibt ein Ereignis in den Ringpuffer.
+     *
+     * @param phase Art
+     * @param track Spur
+     * @param name  Name (String-Literal)
+     */
+    static void record(Phase phase, Track track, const char* name);
+
+    /**
+     * @brief Gibt den Puffer (älteste Einträge zuerst) über stdio aus und leert ihn.
+     *
+     * @details Während der Ausgabe ist die Aufzeichnung angehalten.
+     */
+    static void dump();
+
+    /**
+     * @brief Kopiert die jüngsten Einträge (älteste zuerst), z.B. für das Absturzprotokoll.
+     *
+     * @param out Zielpuffer
+     * @param max Größe des Zielpuffers in Einträgen
+     * @return Anzahl der kopierten Einträge
+     *
+     * @details Ohne Sperren, daher auch aus dem HardFault-Handler aufrufbar.
+     */
+    static size_t copyLast(Event* out, size_t max);
+
+    /**
+     * @brief Hält die Aufzeichnung an bzw. setzt sie fort.
+     */
+    static void setEnabled(bool enable) { enabled.store(enable, std::memory_order_relaxed); }
+
+    /**
+     * @brief RAII-Span: Beginn im Konstruktor, Ende im Destruktor.
+     */
+    class Scope {
+    public:
+        Scope(Track track, const char* name) : track(track), name(name) { record(Phase::BEGIN, track, name); }
+        ~Scope() { record(Phase::END, track, name); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        Track track;
+        const char* name;
+    };
+
+private:
+    /**
+     * @brief Ringpuffer.
+     */
+    static Event events[TRACE_BUFFER_SIZE];
+
+    /**
+     * @brief Anzahl der bisher vergebenen Slots (Schreibposition = head % TRACE_BUFFER_SIZE).
+     *
+     * @threadsafe
+     */
+    static std::atomic<uint32_t> head;
+
+    /**
+     * @brief Aufzeichnung aktiv.
+     *
+     * @threadsafe
+     */
+    static std::atomic<bool> enabled;
+};
+
+#ifdef CABINET_TRACE
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+/** @brief Beginn eines Spans auf einer Spur (z.B. TRACE_BEGIN(MAIN, "render")). */
+#define TRACE_BEGIN(track, name)   Trace::record(Trace::Phase::BEGIN, Trace::Track::track, name)
+/** @brief Ende eines Spans (gleicher Name wie TRACE_BEGIN). */
+#define TRACE_END(track, name)     Trace::record(Trace::Phase::END, Trace::Track::track, name)
+/** @brief Einzelereignis. */
+#define TRACE_INSTANT(track, name) Trace::record(Trace::Phase::INSTANT, Trace::Track::track, name)
+/** @brief Span bis zum Ende des umgebenden Blocks. */
+#define TRACE_SCOPE(track, name)   Trace::Scope TRACE_CONCAT(traceScope_, __LINE__)(Trace::Track::track, name)
+#else
+#define TRACE_BEGIN(track, name)   ((void)0)
+#define TRACE_END(track, name)     ((void)0)
+#define TRACE_INSTANT(track, name) ((void)0)
+#define TRACE_SCOPE(track, name)   ((void)0)
+#endif
+
+#endif // TRACE_H